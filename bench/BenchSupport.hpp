@@ -0,0 +1,132 @@
+#pragma once
+
+#include "../include/core/Slide.hpp"
+#include "../include/interfaces/ISlideRepository.hpp"
+#include "../include/serialization/JsonWriter.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+
+// Helpers shared by the benchmarks: synthetic decks, timing, a scratch
+// directory and a way to silence the serializers' progress messages.
+namespace bench {
+
+// Slide `id` of a synthetic deck, with `texts` numbered text runs and
+// `shapes` shapes cycling through every kind and three scales.
+inline std::unique_ptr<Slide> makeSlide(int id, std::size_t texts, std::size_t shapes) {
+    static const char* const themes[] = {"Light", "Dark", "Corporate"};
+    std::string number = std::to_string(id);
+    auto slide = std::make_unique<Slide>(id, "Slide " + number, "Content of slide " + number, themes[id % 3]);
+    slide->reserve(texts, shapes);
+    for (std::size_t i = 0; i < texts; ++i) {
+        Text text;
+        std::string content = "Text run " + std::to_string(i) + " of slide " + number;
+        text.content = std::string_view(content);
+        text.size = 12.0f + static_cast<float>(i);
+        text.setFont(i % 2 == 0 ? "Arial" : "Helvetica");
+        slide->addText(std::move(text));
+    }
+    for (std::size_t i = 0; i < shapes; ++i) {
+        slide->addShape(Shape(static_cast<ShapeKind>(i % 4), 1.0f + 0.5f * static_cast<float>(i % 3)));
+    }
+    return slide;
+}
+
+inline void fillDeck(ISlideRepository& repo, std::size_t slides, std::size_t texts, std::size_t shapes) {
+    for (std::size_t id = 1; id <= slides; ++id) {
+        repo.addSlide(makeSlide(static_cast<int>(id), texts, shapes));
+    }
+}
+
+// Writes the deck as JsonSerializer would, one slide at a time, so making
+// it costs no more memory than a slide.
+inline void writeDeck(const std::string& filepath, std::size_t slides, std::size_t texts, std::size_t shapes) {
+    std::ofstream out(filepath, std::ios::binary);
+    if (!out.is_open()) throw std::runtime_error("Cannot write " + filepath);
+    JsonWriter writer(out);
+    writer.beginObject();
+    writer.key("language");
+    writer.value("C++");
+    writer.key("slides");
+    writer.beginArray();
+    for (std::size_t id = 1; id <= slides; ++id) {
+        makeSlide(static_cast<int>(id), texts, shapes)->writeJson(writer);
+    }
+    writer.endArray();
+    writer.endObject();
+    writer.flush();
+}
+
+// Shortest of `runs` timings of `run`, in seconds.
+template <typename Run>
+double bestOf(int runs, Run&& run) {
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < runs; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+// Value of `--<name> N` on the command line, or `fallback`.
+inline std::size_t option(int argc, char** argv, const char* name, std::size_t fallback) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strncmp(argv[i], "--", 2) == 0 && std::strcmp(argv[i] + 2, name) == 0) {
+            return static_cast<std::size_t>(std::strtoull(argv[i + 1], nullptr, 10));
+        }
+    }
+    return fallback;
+}
+
+// Temporary directory, removed with everything in it on destruction.
+class ScratchDir {
+public:
+    ScratchDir()
+        : path_(std::filesystem::temp_directory_path() / ("slide-bench-" + std::to_string(std::random_device{}()))) {
+        std::filesystem::create_directories(path_);
+    }
+    ~ScratchDir() {
+        std::error_code error;
+        std::filesystem::remove_all(path_, error);
+    }
+
+    ScratchDir(const ScratchDir&) = delete;
+    ScratchDir& operator=(const ScratchDir&) = delete;
+
+    std::string file(const std::string& name) const { return (path_ / name).string(); }
+
+private:
+    std::filesystem::path path_;
+};
+
+// Discards std::cout output while in scope.
+class QuietOutput {
+public:
+    QuietOutput() : saved_(std::cout.rdbuf(&null_)) {}
+    ~QuietOutput() { std::cout.rdbuf(saved_); }
+
+    QuietOutput(const QuietOutput&) = delete;
+    QuietOutput& operator=(const QuietOutput&) = delete;
+
+private:
+    struct NullBuffer : std::streambuf {
+        int_type overflow(int_type ch) override { return traits_type::not_eof(ch); }
+    };
+
+    NullBuffer null_;
+    std::streambuf* saved_;
+};
+
+}
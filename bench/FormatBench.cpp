@@ -0,0 +1,36 @@
+#include "BenchSupport.hpp"
+#include "../include/core/SlideFactory.hpp"
+#include "../include/core/SlideRepository.hpp"
+#include "../include/serialization/JsonSerializer.hpp"
+#include "../include/serialization/SerializerFactory.hpp"
+#include <cstdio>
+
+// File size, save and load time of each format on a 100k-slide deck, best
+// of 3: the table under "File Formats" in the README.
+int main(int argc, char** argv) {
+    std::size_t slides = bench::option(argc, argv, "slides", 100000);
+    SlideRepository deck;
+    bench::fillDeck(deck, slides, 5, 2);
+    bench::ScratchDir dir;
+
+    std::printf("%-10s %10s %8s %8s\n", "format", "size", "save", "load");
+    for (const char* name : {"deck.json", "deck.cbor", "deck.msgpack", "deck.sbin"}) {
+        std::string filepath = dir.file(name);
+        std::shared_ptr<ISerializer> serializer = SerializerFactory::forFile(filepath);
+        if (!serializer) serializer = std::make_shared<JsonSerializer>();
+
+        double save = bench::bestOf(3, [&] {
+            bench::QuietOutput quiet;
+            serializer->save(deck, filepath);
+        });
+        double load = bench::bestOf(3, [&] {
+            SlideRepository repo;
+            SlideFactory factory;
+            bench::QuietOutput quiet;
+            serializer->load(repo, factory, filepath);
+        });
+        std::printf("%-10s %7.1f MB %6.2f s %6.2f s\n", std::strchr(name, '.') + 1,
+                    std::filesystem::file_size(filepath) / 1e6, save, load);
+    }
+    return 0;
+}
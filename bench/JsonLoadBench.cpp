@@ -0,0 +1,77 @@
+#include "BenchSupport.hpp"
+#include "../include/core/SlideFactory.hpp"
+#include "../include/core/SlideRepository.hpp"
+#include "../include/serialization/JsonSerializer.hpp"
+#include <cstdio>
+#include <functional>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+// JsonSerializer::load (SAX) against parsing a DOM and building slides from
+// it, as load did before, on a 100k-slide deck with 5 text runs per slide.
+// Each loader runs in its own process so its peak RSS is its own.
+namespace {
+
+void loadDom(const std::string& filepath) {
+    SlideRepository repo;
+    std::ifstream file(filepath);
+    nlohmann::json j;
+    file >> j;
+    int maxId = 1;
+    for (const auto& slideJson : j["slides"]) {
+        repo.addSlide(SlideFactory::fromJson(slideJson, maxId, repo.slideResource()));
+    }
+}
+
+void loadSax(const std::string& filepath) {
+    SlideRepository repo;
+    SlideFactory factory;
+    bench::QuietOutput quiet;
+    JsonSerializer().load(repo, factory, filepath);
+}
+
+void report(const char* name, const std::function<void()>& load) {
+    double seconds = bench::bestOf(3, load);
+#if !defined(_WIN32)
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    std::printf("%-8s %8.2f s %8ld MB\n", name, seconds, usage.ru_maxrss / 1024);
+#else
+    std::printf("%-8s %8.2f s %8s\n", name, seconds, "-");
+#endif
+    std::fflush(stdout);
+}
+
+void measure(const char* name, const std::function<void()>& load) {
+#if !defined(_WIN32)
+    pid_t child = fork();
+    if (child == 0) {
+        report(name, load);
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+#else
+    report(name, load);
+#endif
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::size_t slides = bench::option(argc, argv, "slides", 100000);
+    bench::ScratchDir dir;
+    std::string deck = dir.file("deck.json");
+    bench::writeDeck(deck, slides, 5, 0);
+
+    std::printf("%zu slides, %.1f MB\n", slides, std::filesystem::file_size(deck) / 1e6);
+    std::printf("%-8s %10s %11s\n", "loader", "load", "peak RSS");
+    std::fflush(stdout);
+    measure("DOM", [&] { loadDom(deck); });
+    measure("SAX", [&] { loadSax(deck); });
+    return 0;
+}
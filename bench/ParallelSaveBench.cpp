@@ -0,0 +1,34 @@
+#include "BenchSupport.hpp"
+#include "../include/core/SlideRepository.hpp"
+#include "../include/serialization/JsonSerializer.hpp"
+#include <cstdio>
+#include <thread>
+
+// JsonSerializer::save against saveParallel at 1, 2, 4 and 8 workers on a
+// 100k-slide deck, best of 3. With one hardware thread only the overhead
+// of splitting the work shows, not any scaling.
+int main(int argc, char** argv) {
+    std::size_t slides = bench::option(argc, argv, "slides", 100000);
+    SlideRepository repo;
+    bench::fillDeck(repo, slides, 5, 2);
+    bench::ScratchDir dir;
+    std::string target = dir.file("deck.json");
+    JsonSerializer serializer;
+
+    double sequential = bench::bestOf(3, [&] {
+        bench::QuietOutput quiet;
+        serializer.save(repo, target, false);
+    });
+    std::printf("%zu slides, %.1f MB, %u hardware threads\n", slides, std::filesystem::file_size(target) / 1e6,
+                std::thread::hardware_concurrency());
+    std::printf("%-12s %8.2f s\n", "sequential", sequential);
+
+    for (unsigned workers : {1u, 2u, 4u, 8u}) {
+        double parallel = bench::bestOf(3, [&] {
+            bench::QuietOutput quiet;
+            serializer.saveParallel(repo, target, false, workers);
+        });
+        std::printf("%u %-10s %8.2f s\n", workers, workers == 1 ? "worker" : "workers", parallel);
+    }
+    return 0;
+}
@@ -0,0 +1,42 @@
+#include "BenchSupport.hpp"
+#include "../include/core/SlideRepository.hpp"
+#include <cstdio>
+#include <vector>
+
+// getSlideById through the repository's ID index, against the linear scan
+// it replaced, on decks of 1k, 10k and 100k slides.
+int main() {
+    constexpr std::size_t lookups = 200000;
+
+    std::printf("%8s %16s %16s\n", "slides", "index ns/lookup", "scan ns/lookup");
+    for (std::size_t slides : {1000u, 10000u, 100000u}) {
+        SlideRepository repo;
+        bench::fillDeck(repo, slides, 0, 0);
+
+        std::mt19937 random(42);
+        std::uniform_int_distribution<int> pick(1, static_cast<int>(slides));
+        std::vector<int> ids(lookups);
+        for (int& id : ids) id = pick(random);
+
+        // A scan costs O(n), so fewer of them keep each size under a second.
+        std::size_t scans = std::max<std::size_t>(20, 20000000 / slides);
+        long long checksum = 0;
+        double indexed = bench::bestOf(3, [&] {
+            for (int id : ids) checksum += repo.getSlideById(id)->getId();
+        });
+        double scanned = bench::bestOf(3, [&] {
+            for (std::size_t i = 0; i < scans; ++i) {
+                int id = ids[i];
+                const Slide* found = nullptr;
+                static_cast<const SlideRepository&>(repo).forEachSlide([&](const Slide& slide, std::size_t) {
+                    if (!found && slide.getId() == id) found = &slide;
+                });
+                checksum += found->getId();
+            }
+        });
+
+        std::printf("%8zu %16.1f %16.1f\n", slides, indexed / lookups * 1e9, scanned / scans * 1e9);
+        if (checksum == 0) std::printf("unreachable\n");
+    }
+    return 0;
+}
@@ -0,0 +1,48 @@
+#include "BenchSupport.hpp"
+#include "../include/core/SlideRepository.hpp"
+#include "../include/serialization/SvgSerializer.hpp"
+#include <cstdio>
+#include <ostream>
+
+// SvgSerializer::write into a discarding stream on 20k slides with 6 mixed
+// shapes each, without and with 3 texts per slide, best of 7, in shapes
+// emitted per second.
+namespace {
+
+class CountingBuffer : public std::streambuf {
+public:
+    std::size_t bytes = 0;
+
+protected:
+    std::streamsize xsputn(const char*, std::streamsize count) override {
+        bytes += static_cast<std::size_t>(count);
+        return count;
+    }
+    int_type overflow(int_type ch) override {
+        ++bytes;
+        return traits_type::not_eof(ch);
+    }
+};
+
+}
+
+int main(int argc, char** argv) {
+    std::size_t slides = bench::option(argc, argv, "slides", 20000);
+    constexpr std::size_t shapes = 6;
+
+    std::printf("%-16s %10s %14s\n", "deck", "output", "shapes/s");
+    for (std::size_t texts : {0u, 3u}) {
+        SlideRepository repo;
+        bench::fillDeck(repo, slides, texts, shapes);
+        SvgSerializer serializer;
+        CountingBuffer sink;
+        double seconds = bench::bestOf(7, [&] {
+            sink.bytes = 0;
+            std::ostream out(&sink);
+            serializer.write(repo, out);
+        });
+        std::string deck = std::to_string(texts) + " texts/slide";
+        std::printf("%-16s %7.1f MB %12.2f M\n", deck.c_str(), sink.bytes / 1e6, slides * shapes / seconds / 1e6);
+    }
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include "BenchSupport.hpp"
+#include "../include/core/SlideRepository.hpp"
+#include <atomic>
+#include <cstdio>
+#include <new>
+
+// Heap allocations per traversal of a 10k-slide deck: forEachSlide should
+// make none, getAllSlides() one (its vector).
+namespace {
+
+std::atomic<long> allocations{0};
+
+}
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+template <typename Traverse>
+double allocationsPer(int runs, Traverse traverse) {
+    long before = allocations;
+    for (int i = 0; i < runs; ++i) traverse();
+    return static_cast<double>(allocations - before) / runs;
+}
+
+int main() {
+    constexpr int runs = 100;
+    SlideRepository repo;
+    bench::fillDeck(repo, 10000, 3, 2);
+    const SlideRepository& view = repo;
+
+    std::size_t visited = 0;
+    double mutableVisit = allocationsPer(runs, [&] {
+        repo.forEachSlide([&](Slide&, std::size_t) { ++visited; });
+    });
+    double constVisit = allocationsPer(runs, [&] {
+        view.forEachSlide([&](const Slide&, std::size_t) { ++visited; });
+    });
+    double allSlides = allocationsPer(runs, [&] { visited += repo.getAllSlides().size(); });
+
+    std::printf("%-28s %12s\n", "traversal (10k slides)", "allocations");
+    std::printf("%-28s %12.1f\n", "forEachSlide", mutableVisit);
+    std::printf("%-28s %12.1f\n", "forEachSlide (const)", constVisit);
+    std::printf("%-28s %12.1f\n", "getAllSlides", allSlides);
+    return visited == 0;
+}
@@ -28,6 +28,7 @@ public:
 private:
     ISlideRepository& repo_;
     int slideId_;
+    SlideHandle handle_;
     std::size_t textIndex_;
     std::string newContent_;
     float newSize_;
@@ -51,6 +52,7 @@ public:
 private:
     ISlideRepository& repo_;
     int slideId_;
+    SlideHandle handle_;
     std::size_t shapeIndex_;
     ModifyFunc modify_;
     RevertFunc revert_;
@@ -67,8 +69,9 @@ public:
 private:
     ISlideRepository& repo_;
     int slideId_;
+    SlideHandle handle_;
     std::vector<Text> savedTexts_;
-    std::vector<std::unique_ptr<IShape>> savedShapes_;
+    std::vector<Shape> savedShapes_;
     bool executed_ = false;
 };
 
@@ -82,6 +85,7 @@ public:
 private:
     ISlideRepository& repo_;
     int slideId_;
+    SlideHandle handle_;
     std::string newTitle_;
     std::string oldTitle_;
     bool executed_ = false;
@@ -97,6 +101,7 @@ public:
 private:
     ISlideRepository& repo_;
     int sourceSlideId_;
+    SlideHandle sourceHandle_;
     int createdSlideId_ = -1;
     SlideFactory& factory_;
 };
@@ -111,7 +116,9 @@ public:
 private:
     ISlideRepository& repo_;
     int slideId_;
+    SlideHandle handle_;
     nlohmann::json savedSlideJson_;
+    std::size_t savedIndex_ = 0;
     SlideFactory& factory_;
     bool executed_ = false;
 };
@@ -36,6 +36,7 @@ public:
 private:
     ISlideRepository& repo_;
     int slideId_;
+    SlideHandle handle_;
     std::string textContent_;
     float size_;
     std::string font_;
@@ -54,6 +55,7 @@ public:
 private:
     ISlideRepository& repo_;
     int slideId_;
+    SlideHandle handle_;
     std::string shapeType_;
     float scale_;
     std::size_t addedIndex_ = (std::size_t)-1;
@@ -83,6 +85,7 @@ public:
 private:
     ISlideRepository& repo_;
     int slideId_;
+    SlideHandle handle_;
     std::size_t index_;
     Text removedText_;
     bool removed_ = false;
@@ -98,25 +101,32 @@ public:
 private:
     ISlideRepository& repo_;
     int slideId_;
+    SlideHandle handle_;
     std::size_t index_;
-    std::unique_ptr<IShape> removedShape_;
+    Shape removedShape_;
     bool removed_ = false;
 };
 
 class SaveCommand : public ICommand {
 public:
-    SaveCommand(JsonSerializer& serializer, ISlideRepository& repo, const std::string& filepath);
+    SaveCommand(JsonSerializer& serializer, ISlideRepository& repo, const std::string& filepath, bool compact = false,
+                bool journal = false, bool parallel = false, bool async = false);
     void execute() override;
 
 private:
     JsonSerializer& serializer_;
     ISlideRepository& repo_;
     std::string filepath_;
+    bool compact_;
+    bool journal_;
+    bool parallel_;
+    bool async_;
 };
 
 class LoadCommand : public ICommand {
 public:
-    LoadCommand(JsonSerializer& serializer, ISlideRepository& repo, SlideFactory& factory, const std::string& filepath);
+    LoadCommand(JsonSerializer& serializer, ISlideRepository& repo, SlideFactory& factory, const std::string& filepath,
+                bool lazy = false, bool parallel = false);
     void execute() override;
 
 private:
@@ -124,6 +134,8 @@ private:
     ISlideRepository& repo_;
     SlideFactory& factory_;
     std::string filepath_;
+    bool lazy_;
+    bool parallel_;
 };
 
 class DisplayCommand : public ICommand {
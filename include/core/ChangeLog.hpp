@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Order operations and touched slide revisions since the last journal save.
+struct ChangeLog {
+    enum class OpType : std::uint8_t { Insert, Remove, Move, Clear };
+
+    struct Op {
+        OpType type;
+        std::size_t from = 0;
+        std::size_t to = 0;
+        int id = 0;
+    };
+
+    // Revision of slides inserted since the last save; always written.
+    static constexpr std::uint32_t inserted = static_cast<std::uint32_t>(-1);
+
+    bool enabled = false;
+    std::vector<Op> ops;
+    std::unordered_map<int, std::uint32_t> touched;
+};
@@ -1,63 +1,46 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <memory>
 #include "../interfaces/IShape.hpp"
 
-class Triangle : public IShape {
-public:
-    explicit Triangle(float scale = 1.0f);
-    std::string getType() const override;
-    float getScale() const override;
-    void setScale(float scale) override;
-    nlohmann::json toJson() const override;
-    std::string toString() const override;
+class JsonWriter;
 
-private:
-    float scale_;
+enum class ShapeKind : std::uint8_t {
+    Triangle,
+    Circle,
+    Rectangle,
+    Ellipse
 };
 
-class Circle : public IShape {
+// Value-type shape: a kind tag plus a scale, stored inline in Slide.
+// Copying one is a plain copy, so cloning, serializing and rendering a slide
+// never allocate per shape. Shape still implements IShape for callers that
+// work through the interface; the class is final, so direct calls are not
+// dispatched virtually.
+class Shape final : public IShape {
 public:
-    explicit Circle(float scale = 1.0f);
-    std::string getType() const override;
-    float getScale() const override;
-    void setScale(float scale) override;
-    nlohmann::json toJson() const override;
-    std::string toString() const override;
+    explicit Shape(ShapeKind kind = ShapeKind::Triangle, float scale = 1.0f);
+    static Shape fromShape(const IShape& shape);
 
-private:
-    float scale_;
-};
-
-class Rectangle : public IShape {
-public:
-    explicit Rectangle(float scale = 1.0f);
+    ShapeKind getKind() const;
+    const char* typeName() const;
     std::string getType() const override;
     float getScale() const override;
     void setScale(float scale) override;
     nlohmann::json toJson() const override;
+    void writeJson(JsonWriter& writer) const;
     std::string toString() const override;
+    std::unique_ptr<IShape> clone() const override;
 
 private:
-    float scale_;
-};
-
-class Ellipse : public IShape {
-public:
-    explicit Ellipse(float scale = 1.0f);
-    std::string getType() const override;
-    float getScale() const override;
-    void setScale(float scale) override;
-    nlohmann::json toJson() const override;
-    std::string toString() const override;
-    
-private:
+    ShapeKind kind_;
     float scale_;
 };
 
 class ShapeFactory {
 public:
-    static std::unique_ptr<IShape> createShape(const std::string& type, float scale = 1.0f);
-    static std::unique_ptr<IShape> fromJson(const nlohmann::json& j);
-};
\ No newline at end of file
+    static Shape createShape(const std::string& type, float scale = 1.0f);
+    static Shape fromJson(const nlohmann::json& j);
+};
@@ -1,48 +1,94 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <memory>
-#include "../interfaces/IShape.hpp"
+#include <memory_resource>
+#include "Shape.hpp"
+#include "StyleTable.hpp"
 #include <nlohmann/json.hpp>
 
+// Text and Slide are allocator-aware: inside a repository their strings and
+// element vectors live in the repository's memory resource. Text font and
+// color are StyleTable IDs rather than strings.
 struct Text {
-    std::string content;
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+    std::pmr::string content;
     float size = 1.0f;
-    std::string font = "Arial"; 
-    std::string color = "Black";
+    StyleId font = StyleTable::defaultFont;
+    StyleId color = StyleTable::defaultColor;
     float lineWidth = 1.0f;
 
+    Text() : Text(allocator_type{}) {}
+    explicit Text(const allocator_type& alloc);
+    Text(const Text& other, const allocator_type& alloc = {});
+    Text(Text&& other) = default;
+    Text(Text&& other, const allocator_type& alloc);
+    Text& operator=(const Text&) = default;
+    Text& operator=(Text&&) = default;
+
+    const std::string& fontName() const;
+    const std::string& colorName() const;
+    void setFont(std::string_view name);
+    void setColor(std::string_view name);
+
     nlohmann::json toJson() const;
+    void writeJson(JsonWriter& writer) const;
     std::string toString() const;
 };
 
 class Slide {    
 public:
-    Slide(int id, const std::string& title, const std::string& content, const std::string& theme);
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+    Slide(int id, std::string_view title, std::string_view content, std::string_view theme,
+          const allocator_type& alloc = {});
+    Slide(const Slide& other, const allocator_type& alloc = {});
+    // Copy of `other` under another ID.
+    Slide(int id, const Slide& other, const allocator_type& alloc = {});
+    Slide(Slide&& other, const allocator_type& alloc);
+    Slide& operator=(const Slide&) = delete;
+    allocator_type get_allocator() const;
     int getId() const;
     std::string getTitle() const;
     std::string getContent() const;
     std::string getTheme() const;
+    std::string_view titleView() const;
+    std::string_view contentView() const;
+    std::string_view themeView() const;
+    // Bumped by every mutator; the incremental save compares it against the
+    // value seen at the last save to find changed slides.
+    std::uint32_t revision() const;
     void setTitle(const std::string& title);
+    void setContent(std::string_view content);
+    void setTheme(std::string_view theme);
+    void reserve(std::size_t textCount, std::size_t shapeCount);
     void addText(const Text& text);
-    void addShape(std::unique_ptr<IShape> shape);
+    void addText(Text&& text);
+    void addShape(const Shape& shape);
+    void addShape(const IShape& shape);
     void removeText(std::size_t index);
     void removeShape(std::size_t index);
     Text takeText(std::size_t index);
     void insertText(std::size_t index, const Text& text);
-    std::unique_ptr<IShape> takeShape(std::size_t index);
-    void insertShape(std::size_t index, std::unique_ptr<IShape> shape);
-    const std::vector<Text>& getTexts() const;
-    const std::vector<std::unique_ptr<IShape>>& getShapes() const;
+    Shape takeShape(std::size_t index);
+    void insertShape(std::size_t index, const Shape& shape);
+    Shape& getShape(std::size_t index);
+    const std::pmr::vector<Text>& getTexts() const;
+    const std::pmr::vector<Shape>& getShapes() const;
     nlohmann::json toJson() const;
+    void writeJson(JsonWriter& writer) const;
     std::string toString() const;
 
 private:
     int id_;
-    std::string title_;
-    std::string content_;
-    std::string theme_;
-    std::vector<Text> texts_;
-    std::vector<std::unique_ptr<IShape>> shapes_;
+    std::pmr::string title_;
+    std::pmr::string content_;
+    std::pmr::string theme_;
+    std::pmr::vector<Text> texts_;
+    std::pmr::vector<Shape> shapes_;
+    std::uint32_t revision_ = 0;
 };
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <memory_resource>
 #include "Slide.hpp"
 #include <nlohmann/json.hpp>
 
@@ -9,6 +10,10 @@ private:
     int nextId_ = 1;
 public:
     std::unique_ptr<Slide> createSlide(const std::string& title, const std::string& content, const std::string& theme);
-    std::unique_ptr<Slide> fromJson(const nlohmann::json& j, int& maxId);
+    static std::unique_ptr<Slide> fromJson(const nlohmann::json& j, int& maxId,
+                                           std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    static Text textFromJson(const nlohmann::json& j, const Text::allocator_type& alloc = {});
     void resetId(int startId);
+    // Like resetId(), but never lowers the next ID.
+    void advanceId(int minId);
 };
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+// Stable reference to a slide stored in a repository: the slot the slide
+// occupies plus the slot's generation when the handle was issued. Removing a
+// slide bumps its slot's generation, so a stale handle resolves to nullptr in
+// O(1) instead of pointing at whatever reuses the slot.
+struct SlideHandle {
+    static constexpr std::uint32_t invalidSlot = static_cast<std::uint32_t>(-1);
+
+    std::uint32_t slot = invalidSlot;
+    std::uint32_t generation = 0;
+
+    bool isValid() const { return slot != invalidSlot; }
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "../interfaces/ISlideRepository.hpp"
+#include "SlideFactory.hpp"
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Changes that turn one presentation into another, applied in order: removed
+// IDs, per-slide edits (changed fields plus one text and one shape splice),
+// then placements of new and moved slides after a given ID.
+class SlidePatch {
+public:
+    // O(n log n); throws std::runtime_error if either deck repeats an ID.
+    static SlidePatch diff(const ISlideView& from, const ISlideView& to);
+    static SlidePatch fromJson(const nlohmann::json& j);
+    // Hash of everything but the ID; equal slides hash equal.
+    static std::uint64_t contentHash(const Slide& slide);
+
+    bool empty() const;
+    std::size_t changeCount() const;
+    // Throws std::runtime_error, leaving `repo` untouched, if the patch does not fit it.
+    void apply(ISlideRepository& repo, SlideFactory& factory) const;
+    nlohmann::json toJson() const;
+
+private:
+    struct Splice {
+        std::size_t at = 0;
+        std::size_t removed = 0;
+        nlohmann::json inserted = nlohmann::json::array();
+    };
+
+    struct Edit {
+        int id = 0;
+        std::uint64_t base = 0;
+        std::optional<std::string> title;
+        std::optional<std::string> content;
+        std::optional<std::string> theme;
+        std::optional<Splice> texts;
+        std::optional<Splice> shapes;
+    };
+
+    struct Place {
+        int id = 0;
+        std::optional<int> after;
+        // The slide, for slides the patch adds; null for moves.
+        nlohmann::json slide;
+    };
+
+    static Edit diffSlide(const Slide& from, const Slide& to, std::uint64_t base);
+
+    std::vector<int> removed_;
+    std::vector<Edit> edits_;
+    std::vector<Place> placed_;
+};
@@ -1,21 +1,51 @@
 #pragma once
 
 #include "../interfaces/ISlideRepository.hpp"
+#include "SlideSequence.hpp"
+#include "SlideSnapshot.hpp"
 #include <vector>
 #include <memory>
+#include <unordered_map>
 
 class SlideRepository : public ISlideRepository {
 public:
     void addSlide(std::unique_ptr<Slide> slide) override;
+    void insertSlide(std::size_t index, std::unique_ptr<Slide> slide) override;
+    void addLazySlides(std::shared_ptr<const SlideSource> source) override;
     Slide* getSlideById(int id) override;
+    SlideHandle getHandle(int id) const override;
+    Slide* resolve(SlideHandle handle) override;
+    const Slide* resolve(SlideHandle handle) const override;
+    std::size_t indexOf(int id) const override;
+    std::size_t slideCount() const override;
+    Slide* getSlideAt(std::size_t index) override;
+    const Slide* getSlideAt(std::size_t index) const override;
+    void forEachSlide(SlideVisitor visitor) override;
+    void forEachSlide(ConstSlideVisitor visitor) const override;
+    SlideSnapshot snapshot() const override;
+    std::pmr::memory_resource* slideResource() const override;
+    void adoptResource(std::shared_ptr<std::pmr::memory_resource> arena) override;
     void displayAll() const override;
     nlohmann::json toJson() const override;
+    void writeJson(JsonWriter& writer) const override;
     void clear() override;
     void moveSlide(std::size_t fromIndex, std::size_t toIndex) override;
     void removeSlideById(int id) override;
     std::vector<Slide*> getAllSlides() override;
+    const ChangeLog& changes() const override;
+    void markSaved() override;
+    void stopChangeLog() override;
 
 private:
-    std::vector<std::unique_ptr<Slide>> slides_;
-};
+    SlideSequence& mutableSlides();
+    Slide* writableSlide(SlideSequence::Slot slot);
+    std::unordered_multimap<int, SlideSequence::Slot>::const_iterator find(int id) const;
 
+    // Shared with any outstanding snapshots; mutators detach it first.
+    std::shared_ptr<SlideSequence> slides_ = std::make_shared<SlideSequence>();
+    // Slide ID -> sequence slot. Slots survive moves, so only insertions and
+    // removals touch the index. IDs are not guaranteed unique (a loaded file
+    // may repeat one), so an ID can map to several slots.
+    std::unordered_multimap<int, SlideSequence::Slot> index_;
+    ChangeLog changes_;
+};
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Slide.hpp"
+#include "SlideSource.hpp"
+#include "../interfaces/SlideVisitor.hpp"
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+// Ordered slide storage backed by an implicit treap (a randomized balanced
+// tree ordered by position). Nodes live in a single vector and are addressed
+// by slot numbers that never change while the slide is stored, so callers can
+// keep a slot across moves. Each slot also carries a generation that is bumped
+// whenever its slide leaves the sequence. Insert, erase, move and position
+// lookups are O(log n); walking the sequence in order is O(1) amortized per
+// step.
+//
+// Slides are held through shared_ptr so that a copied sequence shares every
+// slide with the original; SlideRepository relies on this for copy-on-write
+// snapshots. The sequence also owns the memory resource its slides are
+// allocated from, keeping it alive for as long as any copy references them.
+// The resource is synchronized: a copy handed to another thread may drop the
+// last reference to a slide there while this thread allocates new ones.
+//
+// A node may instead hold an entry of a SlideSource; its slide is built on
+// first access through get() or holder(). Building mutates the node, so a
+// sequence shared with a snapshot must not be read from two threads until
+// its lazy slides have been touched.
+using RawSlideVisitor = BasicSlideVisitor<const std::string_view>;
+
+class SlideSequence {
+public:
+    using Slot = std::uint32_t;
+    static constexpr Slot npos = static_cast<Slot>(-1);
+
+    SlideSequence();
+
+    std::pmr::memory_resource* resource() const;
+    void resetResource();
+    void adopt(std::shared_ptr<std::pmr::memory_resource> arena);
+    bool owns(const std::pmr::memory_resource* resource) const;
+
+    std::size_t size() const;
+    bool empty() const;
+
+    Slot insert(std::size_t position, std::shared_ptr<Slide> slide);
+    Slot insertLazy(std::size_t position, const std::shared_ptr<const SlideSource>& source, std::uint32_t entry);
+    std::shared_ptr<Slide> erase(Slot slot);
+    void move(std::size_t fromPosition, std::size_t toPosition);
+    void clear();
+
+    Slide* get(Slot slot) const;
+    std::shared_ptr<Slide>& holder(Slot slot);
+    std::uint32_t generation(Slot slot) const;
+    Slot slotAt(std::size_t position) const;
+    std::size_t positionOf(Slot slot) const;
+
+    Slot first() const;
+    Slot next(Slot slot) const;
+    void forEach(ConstSlideVisitor visitor) const;
+    void forEachStored(ConstSlideVisitor visitor, RawSlideVisitor raw) const;
+    void forEachStored(std::size_t begin, std::size_t end, ConstSlideVisitor visitor, RawSlideVisitor raw) const;
+
+private:
+    struct Node {
+        mutable std::shared_ptr<Slide> slide;
+        const SlideSource* source = nullptr;
+        std::uint32_t entry = 0;
+        Slot left = npos;
+        Slot right = npos;
+        Slot parent = npos;
+        std::uint32_t size = 1;
+        std::uint32_t priority = 0;
+        std::uint32_t generation = 0;
+    };
+
+    std::uint32_t sizeOf(Slot slot) const;
+    void update(Slot slot);
+    void split(Slot node, std::size_t count, Slot& left, Slot& right);
+    Slot merge(Slot left, Slot right);
+    Slot allocate(std::shared_ptr<Slide> slide);
+    Slot link(std::size_t position, Slot slot);
+    Slide* materialize(const Node& node) const;
+    void release(Slot slot);
+    std::uint32_t nextPriority();
+
+    std::shared_ptr<std::pmr::memory_resource> resource_;
+    // Other resources stored slides live in, such as loader worker arenas.
+    std::vector<std::shared_ptr<std::pmr::memory_resource>> arenas_;
+    // Keeps every source referenced by a lazy node alive.
+    std::vector<std::shared_ptr<const SlideSource>> sources_;
+    std::vector<Node> nodes_;
+    std::vector<Slot> free_;
+    Slot root_ = npos;
+    std::uint32_t seed_ = 0x9E3779B9u;
+};
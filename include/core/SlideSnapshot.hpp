@@ -0,0 +1,38 @@
+#pragma once
+
+#include "../interfaces/ISlideView.hpp"
+#include "SlideSequence.hpp"
+#include <memory>
+
+// Immutable, structurally shared view of a repository at one point in time.
+// Creating one only copies a pointer; the repository copies its sequence and
+// individual slides lazily when it next mutates them. A snapshot can be read,
+// and released, on another thread while the repository keeps being edited;
+// one holding lazy slides must be isolated() first.
+class SlideSnapshot : public ISlideView {
+public:
+    SlideSnapshot();
+    explicit SlideSnapshot(std::shared_ptr<const SlideSequence> slides);
+
+    std::size_t slideCount() const override;
+    const Slide* getSlideAt(std::size_t index) const override;
+    void forEachSlide(ConstSlideVisitor visitor) const override;
+    void displayAll() const override;
+    nlohmann::json toJson() const override;
+    void writeJson(JsonWriter& writer) const override;
+
+    // writeJson() in three pieces that can be written by separate writers
+    // and concatenated: the document up to the opening of the slides array,
+    // slides [begin, end) as elements of that array, and the rest of the
+    // document after `count` slides. Slide ranges may be written from
+    // several threads at once.
+    static void writeJsonHead(JsonWriter& writer);
+    void writeJsonSlides(JsonWriter& writer, std::size_t begin, std::size_t end) const;
+    static void writeJsonTail(JsonWriter& writer, std::size_t count);
+
+    // O(n) copy with its own nodes, safe to hand to another thread with lazy slides.
+    SlideSnapshot isolated() const;
+
+private:
+    std::shared_ptr<const SlideSequence> slides_;
+};
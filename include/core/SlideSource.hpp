@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Slide.hpp"
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string_view>
+
+// Backing store for lazily loaded slides, built on first access.
+class SlideSource {
+public:
+    virtual ~SlideSource() = default;
+    virtual std::size_t size() const = 0;
+    virtual int idAt(std::size_t entry) const = 0;
+    virtual std::string_view jsonAt(std::size_t entry) const = 0;
+    virtual std::unique_ptr<Slide> materialize(std::size_t entry, std::pmr::memory_resource* resource) const = 0;
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+using StyleId = std::uint32_t;
+
+// Interning table for Text font and color names. Each distinct name is stored
+// once and Text refers to it by a compact ID, so equal styles compare as
+// integers. IDs are never reused, which lets a Text move freely between
+// repositories, snapshots and undo history without re-translating its style.
+// Thread-safe, so loader workers can intern names.
+class StyleTable {
+public:
+    static constexpr StyleId defaultFont = 0;
+    static constexpr StyleId defaultColor = 1;
+
+    static StyleTable& instance();
+
+    StyleId intern(std::string_view name);
+    const std::string& name(StyleId id) const;
+    std::size_t size() const;
+
+private:
+    StyleTable();
+
+    // deque keeps element addresses stable, so ids_ can key on views of them.
+    std::deque<std::string> names_;
+    std::unordered_map<std::string_view, StyleId> ids_;
+    mutable std::shared_mutex mutex_;
+};
@@ -1,12 +1,28 @@
 #pragma once
 
+#include <ostream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include "ISlideRepository.hpp"
 #include "../core/SlideFactory.hpp"
 
 class ISerializer {
 public:
     virtual ~ISerializer() = default;
-    virtual void save(const ISlideRepository& repo, const std::string& filepath) const = 0;
-    virtual void load(ISlideRepository& repo, SlideFactory& factory, const std::string& filepath) = 0;
-};
\ No newline at end of file
+    virtual void save(const ISlideView& view, const std::string& filepath) const = 0;
+    // Prints why and returns false if nothing could be loaded.
+    virtual bool load(ISlideRepository& repo, SlideFactory& factory, const std::string& filepath) = 0;
+
+    // In-memory counterparts of save() and load() for containers that wrap
+    // another format, such as CompressedSerializer. They report problems by
+    // throwing instead of printing, and read() adds nothing to `repo` unless
+    // the whole input is valid. Formats that cannot be wrapped keep these
+    // defaults.
+    virtual void write(const ISlideView&, std::ostream&) const {
+        throw std::runtime_error("format cannot be stored in a container");
+    }
+    virtual void read(ISlideRepository&, SlideFactory&, std::string_view) {
+        throw std::runtime_error("format cannot be stored in a container");
+    }
+};
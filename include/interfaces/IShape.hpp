@@ -1,6 +1,7 @@
 #pragma once
 
 #include <nlohmann/json.hpp>
+#include <memory>
 
 class IShape {
 public:
@@ -10,4 +11,5 @@ public:
     virtual void setScale(float scale) = 0;
     virtual nlohmann::json toJson() const = 0;
     virtual std::string toString() const = 0;
+    virtual std::unique_ptr<IShape> clone() const = 0;
 };
\ No newline at end of file
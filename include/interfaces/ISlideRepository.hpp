@@ -2,17 +2,57 @@
 
 #include <string>
 #include <vector>
+#include "../core/ChangeLog.hpp"
 #include "../core/Slide.hpp"
+#include "../core/SlideHandle.hpp"
+#include "../core/SlideSnapshot.hpp"
+#include "../core/SlideSource.hpp"
+#include "ISlideView.hpp"
+#include "SlideVisitor.hpp"
 
-class ISlideRepository {
+class ISlideRepository : public ISlideView {
 public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    using ISlideView::getSlideAt;
+    using ISlideView::forEachSlide;
+
     virtual ~ISlideRepository() = default;
     virtual void addSlide(std::unique_ptr<Slide> slide) = 0;
+    virtual void insertSlide(std::size_t index, std::unique_ptr<Slide> slide) = 0;
+    // Appends every entry of `source` without building the slides; each one
+    // is materialized when it is first accessed.
+    virtual void addLazySlides(std::shared_ptr<const SlideSource> source) = 0;
     virtual Slide* getSlideById(int id) = 0;
-    virtual void displayAll() const = 0;
-    virtual nlohmann::json toJson() const = 0;
+    virtual SlideHandle getHandle(int id) const = 0;
+    virtual Slide* resolve(SlideHandle handle) = 0;
+    virtual const Slide* resolve(SlideHandle handle) const = 0;
+    virtual std::size_t indexOf(int id) const = 0;
+    virtual Slide* getSlideAt(std::size_t index) = 0;
+    virtual void forEachSlide(SlideVisitor visitor) = 0;
+    virtual SlideSnapshot snapshot() const = 0;
+    virtual std::pmr::memory_resource* slideResource() const = 0;
+    // Shares ownership of `arena`, so slides built in it are stored uncopied.
+    virtual void adoptResource(std::shared_ptr<std::pmr::memory_resource> arena) = 0;
     virtual void clear() = 0;
     virtual void moveSlide(std::size_t fromIndex, std::size_t toIndex) = 0;
     virtual void removeSlideById(int id) = 0;
     virtual std::vector<Slide*> getAllSlides() = 0;
+    // Changes since the last markSaved(). The log stays disabled, and costs
+    // nothing, until markSaved() is first called, and again from
+    // stopChangeLog() until the next markSaved().
+    virtual const ChangeLog& changes() const = 0;
+    virtual void markSaved() = 0;
+    virtual void stopChangeLog() = 0;
+
+    // Resolves `handle`, re-issuing it from `id` when it has gone stale (for
+    // example after the slide was deleted and restored by undo).
+    Slide* resolveSlide(SlideHandle& handle, int id) {
+        if (Slide* slide = resolve(handle)) {
+            return slide;
+        }
+
+        handle = getHandle(id);
+        return resolve(handle);
+    }
 };
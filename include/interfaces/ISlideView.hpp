@@ -0,0 +1,20 @@
+#pragma once
+
+#include "../core/Slide.hpp"
+#include "SlideVisitor.hpp"
+#include <nlohmann/json.hpp>
+
+class JsonWriter;
+
+// Read-only view of a presentation. Implemented by the live repository and by
+// the immutable snapshots it hands out, so serializers can work from either.
+class ISlideView {
+public:
+    virtual ~ISlideView() = default;
+    virtual std::size_t slideCount() const = 0;
+    virtual const Slide* getSlideAt(std::size_t index) const = 0;
+    virtual void forEachSlide(ConstSlideVisitor visitor) const = 0;
+    virtual void displayAll() const = 0;
+    virtual nlohmann::json toJson() const = 0;
+    virtual void writeJson(JsonWriter& writer) const = 0;
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+// Non-owning reference to a callable taking (slide, index). Repositories take
+// visitors by value so that traversal never allocates; the referenced callable
+// only has to outlive the call it is passed to.
+template <typename SlideT>
+class BasicSlideVisitor {
+public:
+    template <typename F,
+              typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, BasicSlideVisitor> &&
+                                          std::is_invocable_v<F&, SlideT&, std::size_t>>>
+    BasicSlideVisitor(F&& callable) noexcept
+        : callable_(const_cast<void*>(static_cast<const void*>(std::addressof(callable)))),
+          invoke_(&invoke<std::remove_reference_t<F>>) {}
+
+    void operator()(SlideT& slide, std::size_t index) const {
+        invoke_(callable_, slide, index);
+    }
+
+private:
+    template <typename F>
+    static void invoke(void* callable, SlideT& slide, std::size_t index) {
+        (*static_cast<F*>(callable))(slide, index);
+    }
+
+    void* callable_;
+    void (*invoke_)(void*, SlideT&, std::size_t);
+};
+
+class Slide;
+using SlideVisitor = BasicSlideVisitor<Slide>;
+using ConstSlideVisitor = BasicSlideVisitor<const Slide>;
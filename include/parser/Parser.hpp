@@ -36,7 +36,9 @@ enum class State {
     REMOVESHAPE_ID,
     REMOVESHAPE_INDEX,
     SAVE_FILE,
+    SAVE_FLAG,
     LOAD_FILE,
+    LOAD_FLAG,
     DISPLAY,
     HELP,
     ERROR
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Background thread running atomic saves in order; a queued save is replaced
+// by a newer one of the same file. Finished jobs are destroyed on the
+// submitting thread, as they may free slides into the repository's resource.
+class AsyncSaver {
+public:
+    // Runs on the background thread, so it must only read a snapshot.
+    using Writer = std::function<void(std::ostream&)>;
+
+    AsyncSaver() = default;
+    ~AsyncSaver();
+
+    AsyncSaver(const AsyncSaver&) = delete;
+    AsyncSaver& operator=(const AsyncSaver&) = delete;
+
+    // `obsolete`, if not empty, is removed once the new file is in place.
+    void submit(const std::string& filepath, Writer writer, const std::string& obsolete = {});
+    // Messages for saves finished since the last call; call it from the submitting thread.
+    std::vector<std::string> takeReports();
+    // Blocks until every submitted save has finished.
+    void wait();
+
+private:
+    struct Job {
+        std::string filepath;
+        Writer writer;
+        std::string obsolete;
+    };
+
+    void run(bool background);
+    static std::string save(const Job& job);
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::deque<Job> jobs_;
+    // Destroyed by the submitting thread.
+    std::vector<Job> finished_;
+    std::vector<std::string> reports_;
+    bool busy_ = false;
+    bool stopping_ = false;
+    std::thread thread_;
+};
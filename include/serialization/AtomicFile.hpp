@@ -0,0 +1,40 @@
+#pragma once
+
+#include <fstream>
+#include <string>
+
+// Output file that replaces its target only once it is complete. Writes go
+// to `<filepath>.tmp`; commit() syncs that file to disk and renames it over
+// `filepath`, so readers, and a crash, see either the old file or the whole
+// new one. A temporary file that was never committed is removed on
+// destruction.
+class AtomicFile {
+public:
+    explicit AtomicFile(const std::string& filepath);
+    ~AtomicFile();
+
+    AtomicFile(const AtomicFile&) = delete;
+    AtomicFile& operator=(const AtomicFile&) = delete;
+
+    bool isOpen() const;
+    std::ostream& stream();
+
+    // Closes the temporary file and moves it into place. `obsolete`, if not
+    // empty, is removed once the new file is in place. Returns false, with
+    // the target and `obsolete` untouched, if any step failed.
+    // Without `durable` nothing is synced: readers still never see a partial
+    // file, but a crash may lose it. That suits output that can be
+    // regenerated, written many files at a time.
+    bool commit(const std::string& obsolete = std::string(), bool durable = true);
+
+    // commit() for a temporary file written by other means. The temporary
+    // file is removed on failure.
+    static bool replace(const std::string& tempPath, const std::string& filepath,
+                        const std::string& obsolete = std::string(), bool durable = true);
+
+private:
+    std::string filepath_;
+    std::string tempPath_;
+    std::ofstream file_;
+    bool pending_ = false;
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "../interfaces/ISerializer.hpp"
+#include <cstdint>
+#include <string>
+
+// Compact binary presentation format (".sbin"). All integers are
+// little-endian.
+//
+//   header       magic "SLDB", u32 version, u32 slideCount, u32 stringCount,
+//                u64 stringTableOffset, u64 slideTableOffset
+//   strings      u32 length + bytes for each distinct string
+//   string table u64 file offset of each string, indexed by string ID
+//   records      content-addressed: each distinct one is stored once
+//                text run  = u32 count, then per text u32 content, u32 font,
+//                            u32 color, f32 size, f32 lineWidth
+//                shape run = u32 count, then per shape u8 kind, 3 bytes
+//                            padding, f32 scale
+//                body      = u32 title, u32 content, u32 theme (string IDs),
+//                            u64 text run, u64 shape run
+//   slide table  per slide i32 id, u32 padding, u64 body
+// Record offsets are relative to the start of the records, which follow
+// the string table. Duplicated slides and template copies that share their
+// texts cost one slide table entry (or one body) each.
+//
+// Loading memory-maps the file and reads records in place. Each string is
+// copied once, straight from the mapping into the repository's memory
+// resource, and font and color names are interned without any copy.
+class BinarySerializer : public ISerializer {
+public:
+    static constexpr std::uint32_t version = 2;
+
+    static bool handles(const std::string& filepath);
+
+    void save(const ISlideView& view, const std::string& filepath) const override;
+    bool load(ISlideRepository& repo, SlideFactory& factory, const std::string& filepath) override;
+    void write(const ISlideView& view, std::ostream& out) const override;
+    void read(ISlideRepository& repo, SlideFactory& factory, std::string_view data) override;
+};
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "PackedJsonSerializer.hpp"
+#include "SerializerFactory.hpp"
+
+// Presentation as CBOR (RFC 8949), for ".cbor" files.
+class CborSerializer : public PackedJsonSerializer {
+public:
+    CborSerializer() : PackedJsonSerializer(Format::Cbor) {}
+
+    static bool handles(const std::string& filepath) { return SerializerFactory::hasExtension(filepath, ".cbor"); }
+};
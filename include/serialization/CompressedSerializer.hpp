@@ -0,0 +1,41 @@
+#pragma once
+
+#include "../interfaces/ISerializer.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Another format wrapped in LzCodec block compression, for files ending in
+// ".slz". The rest of the name picks the wrapped format the usual way:
+// "deck.sbin.slz" holds a binary presentation, "deck.slz" or
+// "deck.json.slz" a JSON one. All integers are little-endian.
+//
+//   header  magic "SLZ1", u32 blockSize
+//   blocks  u32 rawSize, u32 storedSize, then storedSize bytes; the high
+//           bit of storedSize marks a block kept uncompressed
+//   end     u32 0
+//
+// Blocks are compressed independently, so saving compresses one batch of
+// blocks per core while the wrapped format streams into it, and loading
+// decompresses all blocks in parallel before the wrapped format reads the
+// result.
+class CompressedSerializer : public ISerializer {
+public:
+    static constexpr std::uint32_t blockSize = 256 * 1024;
+
+    static bool handles(const std::string& filepath);
+
+    // `workers` = 0 uses one thread per core.
+    explicit CompressedSerializer(std::unique_ptr<ISerializer> inner, unsigned workers = 0);
+
+    void save(const ISlideView& view, const std::string& filepath) const override;
+    bool load(ISlideRepository& repo, SlideFactory& factory, const std::string& filepath) override;
+    void write(const ISlideView& view, std::ostream& out) const override;
+    void read(ISlideRepository& repo, SlideFactory& factory, std::string_view data) override;
+
+private:
+    unsigned threadCount() const;
+
+    std::unique_ptr<ISerializer> inner_;
+    unsigned workers_;
+};
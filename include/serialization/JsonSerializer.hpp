@@ -1,9 +1,48 @@
 #pragma once
 
 #include "../interfaces/ISerializer.hpp"
+#include <cstdint>
+#include <memory>
+
+class AsyncSaver;
 
 class JsonSerializer : public ISerializer {
 public:
-    void save(const ISlideRepository& repo, const std::string& filepath) const override;
-    void load(ISlideRepository& repo, SlideFactory& factory, const std::string& filepath) override;
-};
\ No newline at end of file
+    JsonSerializer();
+    ~JsonSerializer() override;
+
+    void save(const ISlideView& view, const std::string& filepath) const override;
+    void save(const ISlideView& view, const std::string& filepath, bool compact) const;
+    // Same output as save(), with slide ranges serialized on `workers`
+    // threads (0 means one per core).
+    void saveParallel(const ISlideRepository& repo, const std::string& filepath, bool compact,
+                      unsigned workers = 0) const;
+    // Appends changes since the last save to `<filepath>.journal`, or saves
+    // in full after a load or once the journal outgrows half the file.
+    void saveJournal(ISlideRepository& repo, const std::string& filepath);
+    // Saves a snapshot on a background thread; reportSaves() prints the outcome.
+    void saveAsync(const ISlideRepository& repo, const std::string& filepath, bool compact = false);
+    void reportSaves();
+    // Called before touching a file a background save may still be writing.
+    void waitForSaves();
+    bool load(ISlideRepository& repo, SlideFactory& factory, const std::string& filepath) override;
+    bool load(ISlideRepository& repo, SlideFactory& factory, const std::string& filepath, bool lazy);
+    // Indexes the file, then parses its slides on `workers` threads (0 means
+    // one per core). The result is the same as load().
+    bool loadParallel(ISlideRepository& repo, SlideFactory& factory, const std::string& filepath, unsigned workers = 0);
+    void write(const ISlideView& view, std::ostream& out) const override;
+    void read(ISlideRepository& repo, SlideFactory& factory, std::string_view data) override;
+
+private:
+    bool writeFile(const ISlideView& view, const std::string& filepath, bool compact) const;
+    int replayJournal(ISlideRepository& repo, const std::string& filepath, std::size_t base, int maxId) const;
+    void trackJournal(ISlideRepository& repo, const std::string& filepath);
+    void stopJournal(ISlideRepository& repo);
+
+    // File the change log is relative to, and the sizes that decide compaction.
+    mutable std::string journalTarget_;
+    std::uintmax_t baseSize_ = 0;
+    std::uintmax_t journalSize_ = 0;
+    // Created on the first saveAsync().
+    std::unique_ptr<AsyncSaver> saver_;
+};
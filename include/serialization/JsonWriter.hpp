@@ -0,0 +1,56 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Streaming JSON emitter. Output goes into a large in-memory buffer that is
+// flushed to the stream in blocks, so no DOM or whole-file string is built.
+// With an indent it reproduces nlohmann::json::dump(indent) byte for byte;
+// an indent of -1 gives compact output like dump(). Callers must emit
+// object keys in sorted order, as nlohmann's std::map-backed objects do.
+//
+// A writer created without a stream keeps everything in its buffer until
+// take(). Together with resume() this lets pieces of one document be written
+// separately, for example on different threads, and concatenated later.
+class JsonWriter {
+public:
+    explicit JsonWriter(std::ostream& out, int indent = 4);
+    explicit JsonWriter(int indent = 4);
+    ~JsonWriter();
+
+    // Continues as if `depth` containers were open, the innermost already
+    // holding `elements` values, so the next value gets the separator and
+    // indentation it would have had in the whole document.
+    void resume(std::size_t depth, std::size_t elements);
+    std::string take();
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+    void key(std::string_view name);
+    void value(std::string_view str);
+    void value(const char* str);
+    void value(int number);
+    void value(double number);
+    void raw(std::string_view json);
+    void flush();
+
+private:
+    static constexpr std::size_t bufferSize = 1 << 16;
+
+    void beginValue();
+    void newline();
+    void escape(std::string_view str);
+    void put(char c);
+    void put(std::string_view str);
+
+    std::ostream* out_;
+    int indent_;
+    std::string buffer_;
+    // One entry per open container: how many elements it has so far.
+    std::vector<std::size_t> counts_;
+    bool afterKey_ = false;
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "../core/SlideSource.hpp"
+#include "MappedFile.hpp"
+#include <string>
+#include <vector>
+
+// SlideSource over a mapped JSON file, indexed by slide ID and byte range.
+class LazyJsonSource : public SlideSource {
+public:
+    explicit LazyJsonSource(const std::string& filepath);
+
+    bool foundSlides() const;
+    int maxId() const;
+    // Checks every slide without building any.
+    void validate() const;
+
+    std::size_t size() const override;
+    int idAt(std::size_t entry) const override;
+    std::string_view jsonAt(std::size_t entry) const override;
+    std::unique_ptr<Slide> materialize(std::size_t entry, std::pmr::memory_resource* resource) const override;
+
+private:
+    struct Entry {
+        std::size_t offset;
+        std::size_t length;
+        int id;
+    };
+
+    MappedFile file_;
+    std::vector<Entry> entries_;
+    bool foundSlides_ = false;
+    int maxId_ = 1;
+};
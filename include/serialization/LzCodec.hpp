@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+
+// Small LZ77 codec in the LZ4 style, used for compressed presentation files.
+// A compressed block is a series of sequences, each a token byte (literal
+// run length in the high nibble, match length minus 4 in the low nibble;
+// 15 means more length bytes follow, each adding up to 255), the literals,
+// then a 2-byte little-endian match offset. The last sequence has literals
+// only. Matches reach back at most 64 KiB and never cross into another
+// block, so every block decodes on its own.
+class LzCodec {
+public:
+    // Worst-case compressed size of `size` input bytes.
+    static std::size_t bound(std::size_t size);
+
+    // Compresses `size` bytes into `out`, which must hold bound(size)
+    // bytes. Returns the compressed size.
+    static std::size_t compress(const char* in, std::size_t size, char* out);
+
+    // Largest size a compressed block of `size` bytes can decode to: no
+    // input byte, length bytes included, yields more than 255 output bytes.
+    static std::size_t maxDecompressed(std::size_t size);
+
+    // Decompresses a block into exactly `outSize` bytes. Returns false if
+    // the block is malformed or does not decode to that size; it never
+    // reads or writes outside the given buffers.
+    static bool decompress(const char* in, std::size_t size, char* out, std::size_t outSize);
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Read-only view of a whole file (mmap, or a plain read on Windows).
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& filepath);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const;
+    std::size_t size() const;
+    std::string_view view() const;
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+#if defined(_WIN32)
+    std::vector<char> buffer_;
+#endif
+};
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "PackedJsonSerializer.hpp"
+#include "SerializerFactory.hpp"
+
+// Presentation as MessagePack, for ".msgpack" files.
+class MsgPackSerializer : public PackedJsonSerializer {
+public:
+    MsgPackSerializer() : PackedJsonSerializer(Format::MsgPack) {}
+
+    static bool handles(const std::string& filepath) { return SerializerFactory::hasExtension(filepath, ".msgpack"); }
+};
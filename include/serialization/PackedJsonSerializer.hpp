@@ -0,0 +1,31 @@
+#pragma once
+
+#include "../interfaces/ISerializer.hpp"
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Presentation stored as a binary encoding (CBOR or MessagePack) of the same
+// document JsonSerializer writes, so any CBOR or MessagePack reader sees the
+// familiar {"language", "slides"} structure. Saving writes the envelope by
+// hand and encodes one slide at a time; loading streams the mapped file
+// through SlideSaxHandler. Neither builds a DOM of the whole presentation.
+class PackedJsonSerializer : public ISerializer {
+public:
+    enum class Format { Cbor, MsgPack };
+
+    explicit PackedJsonSerializer(Format format);
+
+    void save(const ISlideView& view, const std::string& filepath) const override;
+    bool load(ISlideRepository& repo, SlideFactory& factory, const std::string& filepath) override;
+    void write(const ISlideView& view, std::ostream& out) const override;
+    void read(ISlideRepository& repo, SlideFactory& factory, std::string_view data) override;
+
+private:
+    void writeEnvelope(std::vector<std::uint8_t>& out, std::size_t slideCount) const;
+    void encode(const nlohmann::json& j, std::vector<std::uint8_t>& out) const;
+
+    Format format_;
+};
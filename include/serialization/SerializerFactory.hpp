@@ -0,0 +1,19 @@
+#pragma once
+
+#include "../interfaces/ISerializer.hpp"
+#include <memory>
+#include <string>
+#include <string_view>
+
+class SerializerFactory {
+public:
+    // Serializer for the binary format named by `filepath`'s extension
+    // (".sbin", ".cbor", ".msgpack"), or nullptr for JSON, which callers
+    // handle with their own JsonSerializer and its options. A ".slz" file
+    // gets a CompressedSerializer around the format named by the rest of
+    // the path, JSON included.
+    static std::unique_ptr<ISerializer> forFile(const std::string& filepath);
+
+    // Whether `filepath` ends in `extension`, ignoring ASCII case.
+    static bool hasExtension(std::string_view filepath, std::string_view extension);
+};
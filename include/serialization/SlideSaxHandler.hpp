@@ -0,0 +1,77 @@
+#pragma once
+
+#include "../core/Slide.hpp"
+#include <nlohmann/json.hpp>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+// SAX handler that builds slides straight from the token stream of a saved
+// presentation. Only the slide currently being read is buffered, so parsing
+// needs memory for one slide rather than a DOM of the whole file. Texts are
+// created directly in the target repository's memory resource. Keys the
+// format does not know are skipped, as SlideFactory::fromJson does.
+// `bareSlides` takes one slide object per sax_parse(); `checkOnly` builds nothing.
+class SlideSaxHandler : public nlohmann::json_sax<nlohmann::json> {
+public:
+    explicit SlideSaxHandler(std::pmr::memory_resource* resource, bool bareSlides = false, bool checkOnly = false);
+
+    bool foundSlides() const;
+    int maxId() const;
+    std::vector<std::unique_ptr<Slide>> takeSlides();
+
+    bool null() override;
+    bool boolean(bool val) override;
+    bool number_integer(number_integer_t val) override;
+    bool number_unsigned(number_unsigned_t val) override;
+    bool number_float(number_float_t val, const string_t& s) override;
+    bool string(string_t& val) override;
+    bool binary(binary_t& val) override;
+    bool start_object(std::size_t elements) override;
+    bool key(string_t& val) override;
+    bool end_object() override;
+    bool start_array(std::size_t elements) override;
+    bool end_array() override;
+    bool parse_error(std::size_t position, const std::string& lastToken,
+                     const nlohmann::json::exception& ex) override;
+
+private:
+    enum class Context { Document, Slides, Slide, Texts, Text, Shapes, Shape };
+    enum class Field {
+        None, Slides,
+        Id, Title, Content, Theme, Texts, Shapes,
+        TextContent, TextSize, TextFont, TextColor, TextLineWidth,
+        ShapeType, ShapeScale
+    };
+
+    bool scalar();
+    bool number(double val);
+    void finishSlide();
+    void finishText();
+    void finishShape();
+
+    Slide::allocator_type alloc_;
+    std::vector<Context> contexts_;
+    std::size_t skipDepth_ = 0;
+    bool checkOnly_ = false;
+    Field field_ = Field::None;
+    bool foundSlides_ = false;
+    int maxId_ = 1;
+    std::vector<std::unique_ptr<Slide>> slides_;
+
+    // Fields of the slide, text and shape being read. Keys may arrive in any
+    // order, so a slide is only constructed once its object closes.
+    int id_ = 0;
+    std::string title_;
+    std::string content_;
+    std::string theme_;
+    unsigned slideFields_ = 0;
+    std::pmr::vector<Text> texts_;
+    std::vector<Shape> shapes_;
+    Text text_;
+    unsigned textFields_ = 0;
+    std::string shapeType_;
+    float shapeScale_ = 1.0f;
+    unsigned shapeFields_ = 0;
+};
@@ -1,15 +1,29 @@
 #pragma once
 
 #include "../interfaces/ISerializer.hpp"
+#include "../core/Shape.hpp"
 #include <string>
 
 class SvgSerializer : public ISerializer {
 public:
-    void save(const ISlideRepository& repo, const std::string& filepath) const override;
-    void load(ISlideRepository& repo, SlideFactory& factory, const std::string& filepath) override;
+    // With `symbols`, the slide background and each shape kind and size are
+    // drawn once as a <symbol> in <defs> and placed with <use>, which makes
+    // large decks much smaller. The picture is the same either way.
+    explicit SvgSerializer(bool symbols = false);
+
+    void save(const ISlideView& view, const std::string& filepath) const override;
+    // Same output as save(), with slide ranges rendered on `workers`
+    // threads (0 means one per core).
+    void saveParallel(const ISlideView& view, const std::string& filepath, unsigned workers = 0) const;
+    // Writes each slide to `<directory>/slide-<id>.svg` (`slide-<id>-<n>.svg`
+    // for the nth slide repeating an ID) and lists them in
+    // `<directory>/manifest.json`. Slides whose content is unchanged since
+    // the last export to the same directory are not rendered again.
+    void saveSplit(const ISlideView& view, const std::string& directory) const;
+    bool load(ISlideRepository& repo, SlideFactory& factory, const std::string& filepath) override;
+    // Streams the whole deck as one SVG document, three slides to a row.
+    void write(const ISlideView& view, std::ostream& out) const override;
 
 private:
-    std::string generateSvgContent(const ISlideRepository& repo) const;
-    std::string shapeToSvg(const IShape& shape, int slideIndex, int shapeIndex) const;
-    std::string textToSvg(const Text& text, int slideIndex, int textIndex) const;
+    bool symbols_;
 };
@@ -11,7 +11,7 @@ ModifyTextCommand::ModifyTextCommand(ISlideRepository& repo, int slideId, std::s
       newSize_(newSize), newFont_(newFont), newColor_(newColor) {}
 
 void ModifyTextCommand::execute() {
-    auto slide = repo_.getSlideById(slideId_);
+    auto slide = repo_.resolveSlide(handle_, slideId_);
     if (!slide) return;
 
     const auto& texts = slide->getTexts();
@@ -22,8 +22,8 @@ void ModifyTextCommand::execute() {
 
     if (!newContent_.empty()) modified.content = newContent_;
     if (newSize_ > 0) modified.size = newSize_;
-    if (!newFont_.empty()) modified.font = newFont_;
-    if (!newColor_.empty()) modified.color = newColor_;
+    if (!newFont_.empty()) modified.setFont(newFont_);
+    if (!newColor_.empty()) modified.setColor(newColor_);
 
     slide->removeText(textIndex_);
     slide->insertText(textIndex_, modified);
@@ -33,7 +33,7 @@ void ModifyTextCommand::execute() {
 
 void ModifyTextCommand::undo() {
     if (!executed_) return;
-    auto slide = repo_.getSlideById(slideId_);
+    auto slide = repo_.resolveSlide(handle_, slideId_);
     if (!slide) return;
 
     slide->removeText(textIndex_);
@@ -48,14 +48,13 @@ ModifyShapeCommand::ModifyShapeCommand(ISlideRepository& repo, int slideId, std:
       modify_(modify), revert_(revert) {}
 
 void ModifyShapeCommand::execute() {
-    auto slide = repo_.getSlideById(slideId_);
+    auto slide = repo_.resolveSlide(handle_, slideId_);
     if (!slide) return;
 
-    const auto& shapes = slide->getShapes();
-    if (shapeIndex_ >= shapes.size()) return;
+    if (shapeIndex_ >= slide->getShapes().size()) return;
 
     if (modify_) {
-        modify_(*shapes[shapeIndex_]);
+        modify_(slide->getShape(shapeIndex_));
     }
     executed_ = true;
     std::cout << "Modified shape at index " << shapeIndex_ << " on slide " << slideId_ << std::endl;
@@ -63,14 +62,13 @@ void ModifyShapeCommand::execute() {
 
 void ModifyShapeCommand::undo() {
     if (!executed_) return;
-    auto slide = repo_.getSlideById(slideId_);
+    auto slide = repo_.resolveSlide(handle_, slideId_);
     if (!slide) return;
 
-    const auto& shapes = slide->getShapes();
-    if (shapeIndex_ >= shapes.size()) return;
+    if (shapeIndex_ >= slide->getShapes().size()) return;
 
     if (revert_) {
-        revert_(*shapes[shapeIndex_]);
+        revert_(slide->getShape(shapeIndex_));
     }
     executed_ = false;
     std::cout << "Undo: reverted shape at index " << shapeIndex_ << " on slide " << slideId_ << std::endl;
@@ -80,14 +78,13 @@ ClearSlideCommand::ClearSlideCommand(ISlideRepository& repo, int slideId)
     : repo_(repo), slideId_(slideId) {}
 
 void ClearSlideCommand::execute() {
-    auto slide = repo_.getSlideById(slideId_);
+    auto slide = repo_.resolveSlide(handle_, slideId_);
     if (!slide) return;
 
-    savedTexts_ = slide->getTexts();
-    savedShapes_.clear();
-    for (const auto& shape : slide->getShapes()) {
-        savedShapes_.push_back(ShapeFactory::fromJson(shape->toJson()));
-    }
+    const auto& texts = slide->getTexts();
+    savedTexts_.assign(texts.begin(), texts.end());
+    const auto& shapes = slide->getShapes();
+    savedShapes_.assign(shapes.begin(), shapes.end());
 
     while (!slide->getTexts().empty()) {
         slide->removeText(0);
@@ -102,14 +99,14 @@ void ClearSlideCommand::execute() {
 
 void ClearSlideCommand::undo() {
     if (!executed_) return;
-    auto slide = repo_.getSlideById(slideId_);
+    auto slide = repo_.resolveSlide(handle_, slideId_);
     if (!slide) return;
 
     for (const auto& text : savedTexts_) {
         slide->addText(text);
     }
-    for (auto& shape : savedShapes_) {
-        slide->addShape(std::move(shape));
+    for (const auto& shape : savedShapes_) {
+        slide->addShape(shape);
     }
 
     executed_ = false;
@@ -120,7 +117,7 @@ RenameSlideCommand::RenameSlideCommand(ISlideRepository& repo, int slideId, cons
     : repo_(repo), slideId_(slideId), newTitle_(newTitle) {}
 
 void RenameSlideCommand::execute() {
-    auto slide = repo_.getSlideById(slideId_);
+    auto slide = repo_.resolveSlide(handle_, slideId_);
     if (!slide) return;
 
     oldTitle_ = slide->getTitle();
@@ -131,7 +128,7 @@ void RenameSlideCommand::execute() {
 
 void RenameSlideCommand::undo() {
     if (!executed_) return;
-    auto slide = repo_.getSlideById(slideId_);
+    auto slide = repo_.resolveSlide(handle_, slideId_);
     if (!slide) return;
 
     slide->setTitle(oldTitle_);
@@ -143,7 +140,7 @@ DuplicateSlideCommand::DuplicateSlideCommand(ISlideRepository& repo, SlideFactor
     : repo_(repo), sourceSlideId_(sourceSlideId), factory_(factory) {}
 
 void DuplicateSlideCommand::execute() {
-    auto source = repo_.getSlideById(sourceSlideId_);
+    auto source = repo_.resolveSlide(sourceHandle_, sourceSlideId_);
     if (!source) return;
 
     auto duplicate = factory_.createSlide(source->getTitle() + " (copy)", source->getContent(), source->getTheme());
@@ -152,7 +149,7 @@ void DuplicateSlideCommand::execute() {
         duplicate->addText(text);
     }
     for (const auto& shape : source->getShapes()) {
-        duplicate->addShape(ShapeFactory::fromJson(shape->toJson()));
+        duplicate->addShape(shape);
     }
 
     createdSlideId_ = duplicate->getId();
@@ -172,10 +169,11 @@ DeleteSlideCommand::DeleteSlideCommand(ISlideRepository& repo, SlideFactory& fac
     : repo_(repo), slideId_(slideId), factory_(factory) {}
 
 void DeleteSlideCommand::execute() {
-    auto slide = repo_.getSlideById(slideId_);
+    auto slide = repo_.resolveSlide(handle_, slideId_);
     if (!slide) return;
 
     savedSlideJson_ = slide->toJson();
+    savedIndex_ = repo_.indexOf(slideId_);
 
     repo_.removeSlideById(slideId_);
     executed_ = true;
@@ -187,7 +185,7 @@ void DeleteSlideCommand::undo() {
 
     int dummyMax = 0;
     auto restored = factory_.fromJson(savedSlideJson_, dummyMax);
-    repo_.addSlide(std::move(restored));
+    repo_.insertSlide(std::min(savedIndex_, repo_.slideCount()), std::move(restored));
     executed_ = false;
     std::cout << "Undo: restored deleted slide " << slideId_ << std::endl;
 }
@@ -196,15 +194,8 @@ ReorderSlideCommand::ReorderSlideCommand(ISlideRepository& repo, int slideId, bo
     : repo_(repo), slideId_(slideId), moveUp_(moveUp) {}
 
 void ReorderSlideCommand::execute() {
-    const auto& slides = repo_.getAllSlides();
-    oldIndex_ = 0;
-
-    for (std::size_t i = 0; i < slides.size(); ++i) {
-        if (slides[i]->getId() == slideId_) {
-            oldIndex_ = i;
-            break;
-        }
-    }
+    oldIndex_ = repo_.indexOf(slideId_);
+    if (oldIndex_ == ISlideRepository::npos) return;
 
     if (moveUp_) {
         if (oldIndex_ > 0) {
@@ -213,7 +204,7 @@ void ReorderSlideCommand::execute() {
             return;
         }
     } else {
-        if (oldIndex_ < slides.size() - 1) {
+        if (oldIndex_ + 1 < repo_.slideCount()) {
             newIndex_ = oldIndex_ + 1;
         } else {
             return;
@@ -1,5 +1,6 @@
 #include "../../include/commands/Commands.hpp"
 #include "../../include/core/Shape.hpp"
+#include "../../include/serialization/SerializerFactory.hpp"
 #include <stdexcept>
 #include <iostream>
 
@@ -28,13 +29,13 @@ AddTextCommand::AddTextCommand(ISlideRepository& repo, int slideId, const std::s
     : repo_(repo), slideId_(slideId), textContent_(textContent), size_(size), font_(font), color_(color), lineWidth_(lineWidth) {}
 
 void AddTextCommand::execute() {
-    auto slide = repo_.getSlideById(slideId_);
+    auto slide = repo_.resolveSlide(handle_, slideId_);
     if (slide) {
         Text text;
         text.content = textContent_;
         text.size = size_;
-        text.font = font_;
-        text.color = color_;
+        text.setFont(font_);
+        text.setColor(color_);
         text.lineWidth = lineWidth_;
         slide->addText(text);
         addedIndex_ = slide->getTexts().size() - 1;
@@ -46,7 +47,7 @@ void AddTextCommand::execute() {
 }
 
 void AddTextCommand::undo() {
-    auto slide = repo_.getSlideById(slideId_);
+    auto slide = repo_.resolveSlide(handle_, slideId_);
     if (slide && addedIndex_ != (std::size_t)-1) {
         try {
             slide->removeText(addedIndex_);
@@ -62,11 +63,10 @@ AddShapeCommand::AddShapeCommand(ISlideRepository& repo, unsigned slideId, const
     : repo_(repo), slideId_(slideId), shapeType_(shapeType), scale_(scale) {}
 
 void AddShapeCommand::execute() {
-    auto slide = repo_.getSlideById(slideId_);
+    auto slide = repo_.resolveSlide(handle_, slideId_);
     if (slide) {
         try {
-            auto shape = ShapeFactory::createShape(shapeType_, scale_);
-            slide->addShape(std::move(shape));
+            slide->addShape(ShapeFactory::createShape(shapeType_, scale_));
             addedIndex_ = slide->getShapes().size() - 1;
             std::cout << "Added shape " << shapeType_ << " to slide " << slideId_ << " at index " << addedIndex_ << std::endl;
         } catch (const std::invalid_argument& e) {
@@ -79,7 +79,7 @@ void AddShapeCommand::execute() {
 }
 
 void AddShapeCommand::undo() {
-    auto slide = repo_.getSlideById(slideId_);
+    auto slide = repo_.resolveSlide(handle_, slideId_);
     if (slide && addedIndex_ != (std::size_t)-1) {
         try {
             slide->removeShape(addedIndex_);
@@ -119,7 +119,7 @@ RemoveTextCommand::RemoveTextCommand(ISlideRepository& repo, int slideId, std::s
     : repo_(repo), slideId_(slideId), index_(index) {}
 
 void RemoveTextCommand::execute() {
-    auto slide = repo_.getSlideById(slideId_);
+    auto slide = repo_.resolveSlide(handle_, slideId_);
     if (slide) {
         try {
             removedText_ = slide->takeText(index_);
@@ -136,7 +136,7 @@ void RemoveTextCommand::execute() {
 
 void RemoveTextCommand::undo() {
     if (!removed_) return;
-    auto slide = repo_.getSlideById(slideId_);
+    auto slide = repo_.resolveSlide(handle_, slideId_);
     if (slide) {
         try {
             slide->insertText(index_, removedText_);
@@ -152,7 +152,7 @@ RemoveShapeCommand::RemoveShapeCommand(ISlideRepository& repo, int slideId, std:
     : repo_(repo), slideId_(slideId), index_(index) {}
 
 void RemoveShapeCommand::execute() {
-    auto slide = repo_.getSlideById(slideId_);
+    auto slide = repo_.resolveSlide(handle_, slideId_);
     if (slide) {
         try {
             removedShape_ = slide->takeShape(index_);
@@ -169,10 +169,10 @@ void RemoveShapeCommand::execute() {
 
 void RemoveShapeCommand::undo() {
     if (!removed_) return;
-    auto slide = repo_.getSlideById(slideId_);
-    if (slide && removedShape_) {
+    auto slide = repo_.resolveSlide(handle_, slideId_);
+    if (slide) {
         try {
-            slide->insertShape(index_, std::move(removedShape_));
+            slide->insertShape(index_, removedShape_);
             std::cout << "Undo: reinserted shape at index " << index_ << " on slide " << slideId_ << std::endl;
             removed_ = false;
         } catch (const std::out_of_range& e) {
@@ -181,18 +181,57 @@ void RemoveShapeCommand::undo() {
     }
 }
 
-SaveCommand::SaveCommand(JsonSerializer& serializer, ISlideRepository& repo, const std::string& filepath)
-    : serializer_(serializer), repo_(repo), filepath_(filepath) {}
+SaveCommand::SaveCommand(JsonSerializer& serializer, ISlideRepository& repo, const std::string& filepath, bool compact,
+                         bool journal, bool parallel, bool async)
+    : serializer_(serializer), repo_(repo), filepath_(filepath), compact_(compact), journal_(journal),
+      parallel_(parallel), async_(async) {}
 
 void SaveCommand::execute() {
-    serializer_.save(repo_, filepath_);
+    if (SerializerFactory::forFile(filepath_) && (compact_ || journal_ || parallel_)) {
+        std::cout << "Cannot save " << filepath_ << ": --compact, --journal and --parallel only apply to JSON"
+                  << std::endl;
+        return;
+    }
+    if (async_) {
+        serializer_.saveAsync(repo_, filepath_, compact_);
+        return;
+    }
+    // A background save finishing later would overwrite this one.
+    serializer_.waitForSaves();
+    if (auto serializer = SerializerFactory::forFile(filepath_)) {
+        serializer->save(repo_, filepath_);
+        return;
+    }
+    if (journal_) {
+        serializer_.saveJournal(repo_, filepath_);
+        return;
+    }
+    if (parallel_) {
+        serializer_.saveParallel(repo_, filepath_, compact_);
+        return;
+    }
+    serializer_.save(repo_, filepath_, compact_);
 }
 
-LoadCommand::LoadCommand(JsonSerializer& serializer, ISlideRepository& repo, SlideFactory& factory, const std::string& filepath)
-    : serializer_(serializer), repo_(repo), factory_(factory), filepath_(filepath) {}
+LoadCommand::LoadCommand(JsonSerializer& serializer, ISlideRepository& repo, SlideFactory& factory, const std::string& filepath,
+                         bool lazy, bool parallel)
+    : serializer_(serializer), repo_(repo), factory_(factory), filepath_(filepath), lazy_(lazy), parallel_(parallel) {}
 
 void LoadCommand::execute() {
-    serializer_.load(repo_, factory_, filepath_);
+    serializer_.waitForSaves();
+    if (auto serializer = SerializerFactory::forFile(filepath_)) {
+        if (lazy_ || parallel_) {
+            std::cout << "Cannot load " << filepath_ << ": --lazy and --parallel only apply to JSON" << std::endl;
+            return;
+        }
+        serializer->load(repo_, factory_, filepath_);
+        return;
+    }
+    if (parallel_) {
+        serializer_.loadParallel(repo_, factory_, filepath_);
+        return;
+    }
+    serializer_.load(repo_, factory_, filepath_, lazy_);
 }
 
 DisplayCommand::DisplayCommand(ISlideRepository& repo) : repo_(repo) {}
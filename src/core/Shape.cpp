@@ -1,89 +1,72 @@
 #include "../../include/core/Shape.hpp"
+#include "../../include/serialization/JsonWriter.hpp"
 #include <stdexcept>
 
-Triangle::Triangle(float scale) : scale_(scale) {}
-std::string Triangle::getType() const { return "Triangle"; }
-float Triangle::getScale() const { return scale_; }
+Shape::Shape(ShapeKind kind, float scale) : kind_(kind), scale_(scale) {}
 
-void Triangle::setScale(float scale) { scale_ = scale; }
-
-nlohmann::json Triangle::toJson() const {
-    nlohmann::json j;
-    j["type"] = getType();
-    j["scale"] = scale_;
-    
-    return j;
-}
-
-std::string Triangle::toString() const {
-    return getType() + " (scale: " + std::to_string(scale_) + ")";
+Shape Shape::fromShape(const IShape& shape) {
+    return ShapeFactory::createShape(shape.getType(), shape.getScale());
 }
 
-Circle::Circle(float scale) : scale_(scale) {}
-std::string Circle::getType() const { return "Circle"; }
-float Circle::getScale() const { return scale_; }
-void Circle::setScale(float scale) { scale_ = scale; }
+ShapeKind Shape::getKind() const { return kind_; }
 
-nlohmann::json Circle::toJson() const {
-    nlohmann::json j;
-    j["type"] = getType();
-    j["scale"] = scale_;
+const char* Shape::typeName() const {
+    switch (kind_) {
+        case ShapeKind::Triangle: return "Triangle";
+        case ShapeKind::Circle: return "Circle";
+        case ShapeKind::Rectangle: return "Rectangle";
+        case ShapeKind::Ellipse: return "Ellipse";
+    }
 
-    return j;
+    return "Unknown";
 }
 
-std::string Circle::toString() const {
-    return getType() + " (scale: " + std::to_string(scale_) + ")";
-}
-
-Rectangle::Rectangle(float scale) : scale_(scale) {}
-std::string Rectangle::getType() const { return "Rectangle"; }
-float Rectangle::getScale() const { return scale_; }
-void Rectangle::setScale(float scale) { scale_ = scale; }
+std::string Shape::getType() const { return typeName(); }
+float Shape::getScale() const { return scale_; }
+void Shape::setScale(float scale) { scale_ = scale; }
 
-nlohmann::json Rectangle::toJson() const {
+nlohmann::json Shape::toJson() const {
     nlohmann::json j;
-    j["type"] = getType();
+    j["type"] = typeName();
     j["scale"] = scale_;
 
     return j;
 }
-std::string Rectangle::toString() const {
-    return getType() + " (scale: " + std::to_string(scale_) + ")";
-}
-
-Ellipse::Ellipse(float scale) : scale_(scale) {}
-std::string Ellipse::getType() const { return "Ellipse"; }
-float Ellipse::getScale() const { return scale_; }
-void Ellipse::setScale(float scale) { scale_ = scale; }
 
-nlohmann::json Ellipse::toJson() const {
-    nlohmann::json j;
-    j["type"] = getType();
-    j["scale"] = scale_;
-    return j;
+// Keys in the same sorted order toJson() produces.
+void Shape::writeJson(JsonWriter& writer) const {
+    writer.beginObject();
+    writer.key("scale");
+    writer.value(static_cast<double>(scale_));
+    writer.key("type");
+    writer.value(typeName());
+    writer.endObject();
 }
 
-std::string Ellipse::toString() const {
+std::string Shape::toString() const {
     return getType() + " (scale: " + std::to_string(scale_) + ")";
 }
 
-std::unique_ptr<IShape> ShapeFactory::createShape(const std::string& type, float scale) {
+std::unique_ptr<IShape> Shape::clone() const {
+    return std::make_unique<Shape>(*this);
+}
+
+Shape ShapeFactory::createShape(const std::string& type, float scale) {
     if (type == "Triangle") 
-        return std::make_unique<Triangle>(scale);
+        return Shape(ShapeKind::Triangle, scale);
     if (type == "Circle") 
-        return std::make_unique<Circle>(scale);
+        return Shape(ShapeKind::Circle, scale);
     if (type == "Rectangle") 
-        return std::make_unique<Rectangle>(scale);
+        return Shape(ShapeKind::Rectangle, scale);
     if (type == "Ellipse") 
-        return std::make_unique<Ellipse>(scale);
+        return Shape(ShapeKind::Ellipse, scale);
     
     throw std::invalid_argument("Invalid shape type: " + type);
 }
 
-std::unique_ptr<IShape> ShapeFactory::fromJson(const nlohmann::json& j) {
+Shape ShapeFactory::fromJson(const nlohmann::json& j) {
     std::string type = j["type"];
     float scale = j["scale"];
     
     return createShape(type, scale);
-}
\ No newline at end of file
+}
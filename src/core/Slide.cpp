@@ -1,38 +1,128 @@
 #include "../../include/core/Slide.hpp"
+#include "../../include/serialization/JsonWriter.hpp"
+
+Text::Text(const allocator_type& alloc) : content(alloc) {}
+
+Text::Text(const Text& other, const allocator_type& alloc)
+    : content(other.content, alloc), size(other.size), font(other.font),
+      color(other.color), lineWidth(other.lineWidth) {}
+
+Text::Text(Text&& other, const allocator_type& alloc)
+    : content(std::move(other.content), alloc), size(other.size), font(other.font),
+      color(other.color), lineWidth(other.lineWidth) {}
+
+const std::string& Text::fontName() const { return StyleTable::instance().name(font); }
+const std::string& Text::colorName() const { return StyleTable::instance().name(color); }
+void Text::setFont(std::string_view name) { font = StyleTable::instance().intern(name); }
+void Text::setColor(std::string_view name) { color = StyleTable::instance().intern(name); }
 
 nlohmann::json Text::toJson() const {
     nlohmann::json j;
     j["content"] = content;
     j["size"] = size;
-    j["font"] = font;
-    j["color"] = color;
+    j["font"] = fontName();
+    j["color"] = colorName();
     j["lineWidth"] = lineWidth;
     
     return j;
 }
 
+// writeJson() emits keys in the sorted order nlohmann uses for toJson(), so
+// both produce identical files.
+void Text::writeJson(JsonWriter& writer) const {
+    writer.beginObject();
+    writer.key("color");
+    writer.value(colorName());
+    writer.key("content");
+    writer.value(content);
+    writer.key("font");
+    writer.value(fontName());
+    writer.key("lineWidth");
+    writer.value(static_cast<double>(lineWidth));
+    writer.key("size");
+    writer.value(static_cast<double>(size));
+    writer.endObject();
+}
+
 std::string Text::toString() const {
-    return content + " (size: " + std::to_string(size) + ", font: " + font + ", color: " + color + ", lineWidth: " + std::to_string(lineWidth) + ")";
+    std::string str(content);
+    str += " (size: " + std::to_string(size) + ", font: ";
+    str += fontName();
+    str += ", color: ";
+    str += colorName();
+    str += ", lineWidth: " + std::to_string(lineWidth) + ")";
+    return str;
 }
 
-Slide::Slide(int id, const std::string& title, const std::string& content, const std::string& theme)
-    : id_(id), title_(title), content_(content), theme_(theme) {}
+Slide::Slide(int id, std::string_view title, std::string_view content, std::string_view theme,
+             const allocator_type& alloc)
+    : id_(id), title_(title, alloc), content_(content, alloc), theme_(theme, alloc), texts_(alloc), shapes_(alloc) {}
+
+Slide::Slide(const Slide& other, const allocator_type& alloc)
+    : id_(other.id_), title_(other.title_, alloc), content_(other.content_, alloc), theme_(other.theme_, alloc),
+      texts_(other.texts_, alloc), shapes_(other.shapes_, alloc), revision_(other.revision_) {}
 
+Slide::Slide(int id, const Slide& other, const allocator_type& alloc)
+    : id_(id), title_(other.title_, alloc), content_(other.content_, alloc), theme_(other.theme_, alloc),
+      texts_(other.texts_, alloc), shapes_(other.shapes_, alloc), revision_(other.revision_) {}
+
+Slide::Slide(Slide&& other, const allocator_type& alloc)
+    : id_(other.id_), title_(std::move(other.title_), alloc), content_(std::move(other.content_), alloc),
+      theme_(std::move(other.theme_), alloc), texts_(std::move(other.texts_), alloc),
+      shapes_(std::move(other.shapes_), alloc), revision_(other.revision_) {}
+
+Slide::allocator_type Slide::get_allocator() const { return title_.get_allocator(); }
 int Slide::getId() const { return id_; }
-std::string Slide::getTitle() const { return title_; }
-std::string Slide::getContent() const { return content_; }
-std::string Slide::getTheme() const { return theme_; }
+std::string Slide::getTitle() const { return std::string(title_); }
+std::string Slide::getContent() const { return std::string(content_); }
+std::string Slide::getTheme() const { return std::string(theme_); }
+std::string_view Slide::titleView() const { return title_; }
+std::string_view Slide::contentView() const { return content_; }
+std::string_view Slide::themeView() const { return theme_; }
+std::uint32_t Slide::revision() const { return revision_; }
+
+void Slide::setTitle(const std::string& title) {
+    title_ = title;
+    ++revision_;
+}
+
+void Slide::setContent(std::string_view content) {
+    content_ = content;
+    ++revision_;
+}
+
+void Slide::setTheme(std::string_view theme) {
+    theme_ = theme;
+    ++revision_;
+}
 
-void Slide::setTitle(const std::string& title) { title_ = title; }
+void Slide::reserve(std::size_t textCount, std::size_t shapeCount) {
+    texts_.reserve(textCount);
+    shapes_.reserve(shapeCount);
+}
 
 void Slide::addText(const Text& text) { 
     texts_.push_back(text);
+    ++revision_;
+}
+void Slide::addText(Text&& text) { 
+    texts_.push_back(std::move(text));
+    ++revision_;
+}
+void Slide::addShape(const Shape& shape) {
+    shapes_.push_back(shape);
+    ++revision_;
+}
+void Slide::addShape(const IShape& shape) {
+    shapes_.push_back(Shape::fromShape(shape));
+    ++revision_;
 }
-void Slide::addShape(std::unique_ptr<IShape> shape) { shapes_.push_back(std::move(shape)); }
 
 void Slide::removeText(std::size_t index) {
-    if (index < texts_.size()) 
+    if (index < texts_.size()) {
         texts_.erase(texts_.begin() + index);
+        ++revision_;
+    }
     else 
         throw std::out_of_range("Text index out of range");
 }
@@ -41,6 +131,7 @@ Text Slide::takeText(std::size_t index) {
     if (index < texts_.size()) {
         Text t = texts_[index];
         texts_.erase(texts_.begin() + index);
+        ++revision_;
         return t;
     }
     throw std::out_of_range("Text index out of range");
@@ -49,37 +140,52 @@ Text Slide::takeText(std::size_t index) {
 void Slide::insertText(std::size_t index, const Text& text) {
     if (index <= texts_.size()) {
         texts_.insert(texts_.begin() + index, text);
+        ++revision_;
         return;
     }
     throw std::out_of_range("Text insert index out of range");
 }
 
 void Slide::removeShape(std::size_t index) {
-    if (index < shapes_.size()) 
+    if (index < shapes_.size()) {
         shapes_.erase(shapes_.begin() + index);
+        ++revision_;
+    }
     else 
         throw std::out_of_range("Shape index out of range");
 }
 
-std::unique_ptr<IShape> Slide::takeShape(std::size_t index) {
+Shape Slide::takeShape(std::size_t index) {
     if (index < shapes_.size()) {
-        auto ptr = std::move(shapes_[index]);
+        Shape shape = shapes_[index];
         shapes_.erase(shapes_.begin() + index);
-        return ptr;
+        ++revision_;
+        return shape;
     }
     throw std::out_of_range("Shape index out of range");
 }
 
-void Slide::insertShape(std::size_t index, std::unique_ptr<IShape> shape) {
+void Slide::insertShape(std::size_t index, const Shape& shape) {
     if (index <= shapes_.size()) {
-        shapes_.insert(shapes_.begin() + index, std::move(shape));
+        shapes_.insert(shapes_.begin() + index, shape);
+        ++revision_;
         return;
     }
     throw std::out_of_range("Shape insert index out of range");
 }
 
-const std::vector<Text>& Slide::getTexts() const { return texts_; }
-const std::vector<std::unique_ptr<IShape>>& Slide::getShapes() const { return shapes_; }
+// The caller may modify the returned shape, so handing it out counts as a
+// change.
+Shape& Slide::getShape(std::size_t index) {
+    if (index < shapes_.size()) {
+        ++revision_;
+        return shapes_[index];
+    }
+    throw std::out_of_range("Shape index out of range");
+}
+
+const std::pmr::vector<Text>& Slide::getTexts() const { return texts_; }
+const std::pmr::vector<Shape>& Slide::getShapes() const { return shapes_; }
 
 nlohmann::json Slide::toJson() const {
     nlohmann::json j;
@@ -95,13 +201,36 @@ nlohmann::json Slide::toJson() const {
     j["texts"] = textsJson;
     nlohmann::json shapesJson = nlohmann::json::array();
     for (const auto& shape : shapes_) 
-        shapesJson.push_back(shape->toJson());
+        shapesJson.push_back(shape.toJson());
 
     j["shapes"] = shapesJson;
 
     return j;
 }
 
+void Slide::writeJson(JsonWriter& writer) const {
+    writer.beginObject();
+    writer.key("content");
+    writer.value(content_);
+    writer.key("id");
+    writer.value(id_);
+    writer.key("shapes");
+    writer.beginArray();
+    for (const auto& shape : shapes_) 
+        shape.writeJson(writer);
+    writer.endArray();
+    writer.key("texts");
+    writer.beginArray();
+    for (const auto& text : texts_) 
+        text.writeJson(writer);
+    writer.endArray();
+    writer.key("theme");
+    writer.value(theme_);
+    writer.key("title");
+    writer.value(title_);
+    writer.endObject();
+}
+
 std::string Slide::toString() const {
     std::string str = "Slide ID: " + std::to_string(id_) + "\n";
     str += "Title: " + title_ + "\n";
@@ -114,7 +243,7 @@ std::string Slide::toString() const {
  
     str += "Shapes:\n";
     for (std::size_t i = 0; i < shapes_.size(); ++i) {
-        str += "  [" + std::to_string(i) + "] " + shapes_[i]->toString() + "\n";
+        str += "  [" + std::to_string(i) + "] " + shapes_[i].toString() + "\n";
     }
  
     return str;
@@ -5,20 +5,17 @@ std::unique_ptr<Slide> SlideFactory::createSlide(const std::string& title, const
     return std::make_unique<Slide>(nextId_++, title, content, theme);
 }
 
-std::unique_ptr<Slide> SlideFactory::fromJson(const nlohmann::json& j, int& maxId) {
+std::unique_ptr<Slide> SlideFactory::fromJson(const nlohmann::json& j, int& maxId, std::pmr::memory_resource* resource) {
     int id = j["id"];
     maxId = std::max(maxId, id + 1);
-    auto slide = std::make_unique<Slide>(id, j["title"], j["content"], j["theme"]);
+    Slide::allocator_type alloc(resource);
+    auto slide = std::make_unique<Slide>(id, j["title"].get_ref<const std::string&>(), j["content"].get_ref<const std::string&>(),
+                                         j["theme"].get_ref<const std::string&>(), alloc);
+    slide->reserve(j.contains("texts") ? j["texts"].size() : 0, j.contains("shapes") ? j["shapes"].size() : 0);
 
     if (j.contains("texts") && j["texts"].is_array()) {
         for (const auto& textJson : j["texts"]) {
-            Text text;
-            text.content = textJson["content"];
-            text.size = textJson["size"];
-            text.font = textJson.value("font", "Arial");
-            text.color = textJson.value("color", "Black");
-            text.lineWidth = textJson.value("lineWidth", 1.0f);
-            slide->addText(text);
+            slide->addText(textFromJson(textJson, alloc));
         }
     }
 
@@ -31,4 +28,16 @@ std::unique_ptr<Slide> SlideFactory::fromJson(const nlohmann::json& j, int& maxI
     return slide;
 }
 
-void SlideFactory::resetId(int startId) { nextId_ = startId; }
\ No newline at end of file
+Text SlideFactory::textFromJson(const nlohmann::json& j, const Text::allocator_type& alloc) {
+    Text text(alloc);
+    text.content = j["content"].get_ref<const std::string&>();
+    text.size = j["size"];
+    if (j.contains("font")) text.setFont(j["font"].get_ref<const std::string&>());
+    if (j.contains("color")) text.setColor(j["color"].get_ref<const std::string&>());
+    text.lineWidth = j.value("lineWidth", 1.0f);
+    return text;
+}
+
+void SlideFactory::resetId(int startId) { nextId_ = startId; }
+
+void SlideFactory::advanceId(int minId) { nextId_ = std::max(nextId_, minId); }
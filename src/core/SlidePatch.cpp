@@ -0,0 +1,410 @@
+#include "../../include/core/SlidePatch.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+// 64-bit FNV-1a. Strings are prefixed with their length so that field
+// boundaries are part of the hash.
+class Hasher {
+public:
+    void bytes(const void* data, std::size_t size) {
+        const auto* p = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash_ = (hash_ ^ p[i]) * 1099511628211ull;
+        }
+    }
+
+    void number(std::uint64_t value) { bytes(&value, sizeof(value)); }
+
+    void real(float value) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        number(bits);
+    }
+
+    void string(std::string_view value) {
+        number(value.size());
+        bytes(value.data(), value.size());
+    }
+
+    std::uint64_t value() const { return hash_; }
+
+private:
+    std::uint64_t hash_ = 14695981039346656037ull;
+};
+
+bool sameText(const Text& a, const Text& b) {
+    return a.content == b.content && a.size == b.size && a.font == b.font && a.color == b.color &&
+           a.lineWidth == b.lineWidth;
+}
+
+bool sameShape(const Shape& a, const Shape& b) {
+    return a.getKind() == b.getKind() && a.getScale() == b.getScale();
+}
+
+// Lengths of the common prefix and, in what is left, the common suffix.
+template <typename Elements, typename Same>
+std::pair<std::size_t, std::size_t> commonEnds(const Elements& from, const Elements& to, Same same) {
+    std::size_t limit = std::min(from.size(), to.size());
+    std::size_t prefix = 0;
+    while (prefix < limit && same(from[prefix], to[prefix])) {
+        ++prefix;
+    }
+    std::size_t suffix = 0;
+    while (prefix + suffix < limit && same(from[from.size() - 1 - suffix], to[to.size() - 1 - suffix])) {
+        ++suffix;
+    }
+    return {prefix, suffix};
+}
+
+// Marks the elements of a longest strictly increasing subsequence
+// (patience sorting, O(n log n)).
+std::vector<bool> longestIncreasing(const std::vector<std::size_t>& values) {
+    constexpr std::size_t none = static_cast<std::size_t>(-1);
+    std::vector<std::size_t> tails;
+    std::vector<std::size_t> previous(values.size(), none);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        auto it = std::lower_bound(tails.begin(), tails.end(), values[i],
+                                   [&values](std::size_t tail, std::size_t value) { return values[tail] < value; });
+        if (it != tails.begin()) {
+            previous[i] = *(it - 1);
+        }
+        if (it == tails.end()) {
+            tails.push_back(i);
+        } else {
+            *it = i;
+        }
+    }
+
+    std::vector<bool> marked(values.size(), false);
+    for (std::size_t i = tails.empty() ? none : tails.back(); i != none; i = previous[i]) {
+        marked[i] = true;
+    }
+    return marked;
+}
+
+[[noreturn]] void mismatch(const std::string& reason) {
+    throw std::runtime_error("Patch does not fit this presentation: " + reason);
+}
+
+[[noreturn]] void repeatedId(int id) {
+    throw std::runtime_error("Cannot diff presentations that repeat slide ID " + std::to_string(id));
+}
+
+}
+
+std::uint64_t SlidePatch::contentHash(const Slide& slide) {
+    Hasher hasher;
+    hasher.string(slide.titleView());
+    hasher.string(slide.contentView());
+    hasher.string(slide.themeView());
+    hasher.number(slide.getTexts().size());
+    for (const auto& text : slide.getTexts()) {
+        hasher.string(text.content);
+        hasher.real(text.size);
+        hasher.string(text.fontName());
+        hasher.string(text.colorName());
+        hasher.real(text.lineWidth);
+    }
+    hasher.number(slide.getShapes().size());
+    for (const auto& shape : slide.getShapes()) {
+        hasher.number(static_cast<std::uint64_t>(shape.getKind()));
+        hasher.real(shape.getScale());
+    }
+    return hasher.value();
+}
+
+SlidePatch::Edit SlidePatch::diffSlide(const Slide& from, const Slide& to, std::uint64_t base) {
+    Edit edit;
+    edit.id = to.getId();
+    edit.base = base;
+    if (from.titleView() != to.titleView()) edit.title = to.getTitle();
+    if (from.contentView() != to.contentView()) edit.content = to.getContent();
+    if (from.themeView() != to.themeView()) edit.theme = to.getTheme();
+
+    const auto& oldTexts = from.getTexts();
+    const auto& newTexts = to.getTexts();
+    auto [textPrefix, textSuffix] = commonEnds(oldTexts, newTexts, sameText);
+    if (textPrefix + textSuffix < std::max(oldTexts.size(), newTexts.size())) {
+        Splice splice;
+        splice.at = textPrefix;
+        splice.removed = oldTexts.size() - textPrefix - textSuffix;
+        for (std::size_t i = textPrefix; i < newTexts.size() - textSuffix; ++i) {
+            splice.inserted.push_back(newTexts[i].toJson());
+        }
+        edit.texts = std::move(splice);
+    }
+
+    const auto& oldShapes = from.getShapes();
+    const auto& newShapes = to.getShapes();
+    auto [shapePrefix, shapeSuffix] = commonEnds(oldShapes, newShapes, sameShape);
+    if (shapePrefix + shapeSuffix < std::max(oldShapes.size(), newShapes.size())) {
+        Splice splice;
+        splice.at = shapePrefix;
+        splice.removed = oldShapes.size() - shapePrefix - shapeSuffix;
+        for (std::size_t i = shapePrefix; i < newShapes.size() - shapeSuffix; ++i) {
+            splice.inserted.push_back(newShapes[i].toJson());
+        }
+        edit.shapes = std::move(splice);
+    }
+    return edit;
+}
+
+SlidePatch SlidePatch::diff(const ISlideView& from, const ISlideView& to) {
+    struct Old {
+        std::size_t position;
+        const Slide* slide;
+        bool kept;
+    };
+
+    std::unordered_map<int, Old> old;
+    old.reserve(from.slideCount());
+    std::vector<const Slide*> oldOrder;
+    oldOrder.reserve(from.slideCount());
+    from.forEachSlide([&](const Slide& slide, std::size_t index) {
+        if (!old.emplace(slide.getId(), Old{index, &slide, false}).second) {
+            repeatedId(slide.getId());
+        }
+        oldOrder.push_back(&slide);
+    });
+
+    SlidePatch patch;
+    std::vector<const Slide*> newOrder;
+    newOrder.reserve(to.slideCount());
+    // Old positions of the slides both sides have, in their new order.
+    std::vector<std::size_t> oldPositions;
+    std::unordered_set<int> newIds;
+    newIds.reserve(to.slideCount());
+    to.forEachSlide([&](const Slide& slide, std::size_t) {
+        if (!newIds.insert(slide.getId()).second) {
+            repeatedId(slide.getId());
+        }
+        newOrder.push_back(&slide);
+        auto it = old.find(slide.getId());
+        if (it == old.end()) {
+            return;
+        }
+
+        it->second.kept = true;
+        oldPositions.push_back(it->second.position);
+        if (it->second.slide == &slide) {
+            // Shared by a snapshot and its repository: unchanged.
+            return;
+        }
+        std::uint64_t base = contentHash(*it->second.slide);
+        if (base != contentHash(slide)) {
+            Edit edit = diffSlide(*it->second.slide, slide, base);
+            if (edit.title || edit.content || edit.theme || edit.texts || edit.shapes) {
+                patch.edits_.push_back(std::move(edit));
+            }
+        }
+    });
+
+    for (const Slide* slide : oldOrder) {
+        if (!old.at(slide->getId()).kept) {
+            patch.removed_.push_back(slide->getId());
+        }
+    }
+
+    std::vector<bool> inOrder = longestIncreasing(oldPositions);
+    std::size_t common = 0;
+    std::optional<int> after;
+    for (const Slide* slide : newOrder) {
+        if (old.find(slide->getId()) == old.end()) {
+            patch.placed_.push_back({slide->getId(), after, slide->toJson()});
+        } else if (!inOrder[common++]) {
+            patch.placed_.push_back({slide->getId(), after, nullptr});
+        }
+        after = slide->getId();
+    }
+    return patch;
+}
+
+bool SlidePatch::empty() const {
+    return changeCount() == 0;
+}
+
+std::size_t SlidePatch::changeCount() const {
+    return removed_.size() + edits_.size() + placed_.size();
+}
+
+// Everything that can fail (lookups, hash checks, parsing the new texts,
+// shapes and slides) happens before the first change to `repo`.
+void SlidePatch::apply(ISlideRepository& repo, SlideFactory& factory) const {
+    const ISlideRepository& view = repo;
+    std::unordered_set<int> removed;
+    for (int id : removed_) {
+        if (view.indexOf(id) == ISlideRepository::npos || !removed.insert(id).second) {
+            mismatch("no slide " + std::to_string(id) + " to remove");
+        }
+    }
+    auto present = [&](int id) { return view.indexOf(id) != ISlideRepository::npos && removed.count(id) == 0; };
+
+    struct Prepared {
+        std::vector<Text> texts;
+        std::vector<Shape> shapes;
+    };
+    std::vector<Prepared> prepared(edits_.size());
+    for (std::size_t i = 0; i < edits_.size(); ++i) {
+        const Edit& edit = edits_[i];
+        if (!present(edit.id)) {
+            mismatch("no slide " + std::to_string(edit.id) + " to edit");
+        }
+        const Slide& slide = *view.getSlideAt(view.indexOf(edit.id));
+        if (contentHash(slide) != edit.base ||
+            (edit.texts && edit.texts->at + edit.texts->removed > slide.getTexts().size()) ||
+            (edit.shapes && edit.shapes->at + edit.shapes->removed > slide.getShapes().size())) {
+            mismatch("slide " + std::to_string(edit.id) + " has changed");
+        }
+        if (edit.texts) {
+            for (const auto& textJson : edit.texts->inserted) {
+                prepared[i].texts.push_back(SlideFactory::textFromJson(textJson));
+            }
+        }
+        if (edit.shapes) {
+            for (const auto& shapeJson : edit.shapes->inserted) {
+                prepared[i].shapes.push_back(ShapeFactory::fromJson(shapeJson));
+            }
+        }
+    }
+
+    int maxId = 1;
+    std::vector<std::unique_ptr<Slide>> added(placed_.size());
+    std::unordered_set<int> placed;
+    for (std::size_t i = 0; i < placed_.size(); ++i) {
+        const Place& place = placed_[i];
+        if (place.after && !present(*place.after) && placed.count(*place.after) == 0) {
+            mismatch("no slide " + std::to_string(*place.after) + " to place after");
+        }
+        if (place.slide.is_null()) {
+            if (!present(place.id)) {
+                mismatch("no slide " + std::to_string(place.id) + " to move");
+            }
+        } else {
+            if (present(place.id) || placed.count(place.id) != 0) {
+                mismatch("slide " + std::to_string(place.id) + " already exists");
+            }
+            added[i] = SlideFactory::fromJson(place.slide, maxId, repo.slideResource());
+            if (added[i]->getId() != place.id) {
+                throw std::runtime_error("Corrupt patch: slide ID mismatch");
+            }
+        }
+        placed.insert(place.id);
+    }
+
+    for (int id : removed_) {
+        repo.removeSlideById(id);
+    }
+
+    for (std::size_t i = 0; i < edits_.size(); ++i) {
+        const Edit& edit = edits_[i];
+        Slide* slide = repo.getSlideById(edit.id);
+        if (edit.title) slide->setTitle(*edit.title);
+        if (edit.content) slide->setContent(*edit.content);
+        if (edit.theme) slide->setTheme(*edit.theme);
+        if (edit.texts) {
+            for (std::size_t k = 0; k < edit.texts->removed; ++k) {
+                slide->removeText(edit.texts->at);
+            }
+            for (std::size_t k = 0; k < prepared[i].texts.size(); ++k) {
+                slide->insertText(edit.texts->at + k, prepared[i].texts[k]);
+            }
+        }
+        if (edit.shapes) {
+            for (std::size_t k = 0; k < edit.shapes->removed; ++k) {
+                slide->removeShape(edit.shapes->at);
+            }
+            for (std::size_t k = 0; k < prepared[i].shapes.size(); ++k) {
+                slide->insertShape(edit.shapes->at + k, prepared[i].shapes[k]);
+            }
+        }
+    }
+
+    // Each slide goes directly after its new predecessor, which is either
+    // already in place or was placed by an earlier entry.
+    for (std::size_t i = 0; i < placed_.size(); ++i) {
+        const Place& place = placed_[i];
+        std::size_t target = place.after ? view.indexOf(*place.after) + 1 : 0;
+        if (added[i]) {
+            repo.insertSlide(target, std::move(added[i]));
+            continue;
+        }
+
+        std::size_t position = view.indexOf(place.id);
+        if (position < target) {
+            --target;
+        }
+        if (position != target) {
+            repo.moveSlide(position, target);
+        }
+    }
+    factory.advanceId(maxId);
+}
+
+nlohmann::json SlidePatch::toJson() const {
+    auto splice = [](const Splice& s) { return nlohmann::json::array({s.at, s.removed, s.inserted}); };
+
+    nlohmann::json j;
+    j["patch"] = 1;
+    j["remove"] = removed_;
+    j["edit"] = nlohmann::json::array();
+    for (const auto& edit : edits_) {
+        nlohmann::json e;
+        e["id"] = edit.id;
+        e["base"] = edit.base;
+        if (edit.title) e["title"] = *edit.title;
+        if (edit.content) e["content"] = *edit.content;
+        if (edit.theme) e["theme"] = *edit.theme;
+        if (edit.texts) e["texts"] = splice(*edit.texts);
+        if (edit.shapes) e["shapes"] = splice(*edit.shapes);
+        j["edit"].push_back(std::move(e));
+    }
+    j["place"] = nlohmann::json::array();
+    for (const auto& place : placed_) {
+        nlohmann::json p = nlohmann::json::array({place.id, place.after ? nlohmann::json(*place.after) : nlohmann::json()});
+        if (!place.slide.is_null()) p.push_back(place.slide);
+        j["place"].push_back(std::move(p));
+    }
+    return j;
+}
+
+SlidePatch SlidePatch::fromJson(const nlohmann::json& j) {
+    if (!j.is_object() || j.value("patch", 0) != 1) {
+        throw std::runtime_error("Not a slide patch");
+    }
+
+    auto splice = [](const nlohmann::json& s) {
+        Splice result;
+        result.at = s.at(0).get<std::size_t>();
+        result.removed = s.at(1).get<std::size_t>();
+        result.inserted = s.at(2);
+        if (!result.inserted.is_array()) throw std::runtime_error("Corrupt patch: bad splice");
+        return result;
+    };
+
+    SlidePatch patch;
+    patch.removed_ = j.at("remove").get<std::vector<int>>();
+    for (const auto& e : j.at("edit")) {
+        Edit edit;
+        edit.id = e.at("id").get<int>();
+        edit.base = e.at("base").get<std::uint64_t>();
+        if (e.contains("title")) edit.title = e["title"].get<std::string>();
+        if (e.contains("content")) edit.content = e["content"].get<std::string>();
+        if (e.contains("theme")) edit.theme = e["theme"].get<std::string>();
+        if (e.contains("texts")) edit.texts = splice(e["texts"]);
+        if (e.contains("shapes")) edit.shapes = splice(e["shapes"]);
+        patch.edits_.push_back(std::move(edit));
+    }
+    for (const auto& p : j.at("place")) {
+        Place place;
+        place.id = p.at(0).get<int>();
+        if (!p.at(1).is_null()) place.after = p.at(1).get<int>();
+        if (p.size() > 2) place.slide = p.at(2);
+        patch.placed_.push_back(std::move(place));
+    }
+    return patch;
+}
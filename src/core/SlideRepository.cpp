@@ -1,64 +1,239 @@
 #include "../../include/core/SlideRepository.hpp"
 #include <iostream>
+#include <iterator>
 
 void SlideRepository::addSlide(std::unique_ptr<Slide> slide) {
-    slides_.push_back(std::move(slide));
+    insertSlide(slides_->size(), std::move(slide));
 }
 
-Slide* SlideRepository::getSlideById(int id) {
-    for (auto& slide : slides_) {
-        if (slide->getId() == id) {
-            return slide.get();
+// Slides are moved into the repository's memory resource so that a whole
+// presentation sits in one arena. Slides built with slideResource() or an
+// adopted arena (as the loaders do) are moved without copying their contents.
+void SlideRepository::insertSlide(std::size_t index, std::unique_ptr<Slide> slide) {
+    int id = slide->getId();
+    SlideSequence& slides = mutableSlides();
+    std::pmr::memory_resource* resource = slide->get_allocator().resource();
+    std::pmr::polymorphic_allocator<Slide> alloc(slides.owns(resource) ? resource : slides.resource());
+    SlideSequence::Slot slot = slides.insert(index, std::allocate_shared<Slide>(alloc, std::move(*slide)));
+    index_.emplace(id, slot);
+    if (changes_.enabled) {
+        changes_.ops.push_back({ChangeLog::OpType::Insert, index, 0, id});
+        changes_.touched[id] = ChangeLog::inserted;
+    }
+}
+
+void SlideRepository::addLazySlides(std::shared_ptr<const SlideSource> source) {
+    SlideSequence& slides = mutableSlides();
+    index_.reserve(index_.size() + source->size());
+    for (std::size_t entry = 0; entry < source->size(); ++entry) {
+        SlideSequence::Slot slot = slides.insertLazy(slides.size(), source, static_cast<std::uint32_t>(entry));
+        int id = source->idAt(entry);
+        index_.emplace(id, slot);
+        if (changes_.enabled) {
+            changes_.ops.push_back({ChangeLog::OpType::Insert, slides.size() - 1, 0, id});
+            changes_.touched[id] = ChangeLog::inserted;
         }
     }
+}
 
-    return nullptr;
+Slide* SlideRepository::getSlideById(int id) {
+    auto it = find(id);
+    if (it == index_.end()) {
+        return nullptr;
+    }
+
+    return writableSlide(it->second);
 }
 
-void SlideRepository::displayAll() const {
-    for (const auto& slide : slides_) {
-        std::cout << slide->toString() << "-------------------\n";
+SlideHandle SlideRepository::getHandle(int id) const {
+    auto it = find(id);
+    if (it == index_.end()) {
+        return SlideHandle{};
     }
+
+    return SlideHandle{it->second, slides_->generation(it->second)};
 }
 
-nlohmann::json SlideRepository::toJson() const {
-    nlohmann::json j;
-    j["language"] = "C++";
-    nlohmann::json slidesJson = nlohmann::json::array();
-    for (const auto& slide : slides_) {
-        slidesJson.push_back(slide->toJson());
+Slide* SlideRepository::resolve(SlideHandle handle) {
+    if (!static_cast<const SlideRepository&>(*this).resolve(handle)) {
+        return nullptr;
+    }
+
+    return writableSlide(handle.slot);
+}
+
+const Slide* SlideRepository::resolve(SlideHandle handle) const {
+    const Slide* slide = handle.isValid() ? slides_->get(handle.slot) : nullptr;
+    if (!slide || slides_->generation(handle.slot) != handle.generation) {
+        return nullptr;
+    }
+
+    return slide;
+}
+
+std::size_t SlideRepository::indexOf(int id) const {
+    auto it = find(id);
+    if (it == index_.end()) {
+        return npos;
+    }
+
+    return slides_->positionOf(it->second);
+}
+
+std::size_t SlideRepository::slideCount() const {
+    return slides_->size();
+}
+
+Slide* SlideRepository::getSlideAt(std::size_t index) {
+    SlideSequence::Slot slot = slides_->slotAt(index);
+    if (slot == SlideSequence::npos) {
+        return nullptr;
+    }
+
+    return writableSlide(slot);
+}
+
+const Slide* SlideRepository::getSlideAt(std::size_t index) const {
+    return slides_->get(slides_->slotAt(index));
+}
+
+void SlideRepository::forEachSlide(SlideVisitor visitor) {
+    std::size_t index = 0;
+    for (auto slot = slides_->first(); slot != SlideSequence::npos; slot = slides_->next(slot)) {
+        visitor(*writableSlide(slot), index++);
     }
- 
-    j["slides"] = slidesJson;
-    return j;
+}
+
+void SlideRepository::forEachSlide(ConstSlideVisitor visitor) const {
+    slides_->forEach(visitor);
+}
+
+SlideSnapshot SlideRepository::snapshot() const {
+    return SlideSnapshot(slides_);
+}
+
+std::pmr::memory_resource* SlideRepository::slideResource() const {
+    return slides_->resource();
+}
+
+void SlideRepository::adoptResource(std::shared_ptr<std::pmr::memory_resource> arena) {
+    mutableSlides().adopt(std::move(arena));
+}
+
+void SlideRepository::displayAll() const {
+    SlideSnapshot(slides_).displayAll();
+}
+
+nlohmann::json SlideRepository::toJson() const {
+    return SlideSnapshot(slides_).toJson();
+}
+
+void SlideRepository::writeJson(JsonWriter& writer) const {
+    SlideSnapshot(slides_).writeJson(writer);
 }
 
 void SlideRepository::clear() {
-    slides_.clear();
+    mutableSlides().clear();
+    slides_->resetResource();
+    index_.clear();
+    if (changes_.enabled) {
+        // Nothing logged before a clear matters any more.
+        changes_.ops.assign(1, {ChangeLog::OpType::Clear});
+        changes_.touched.clear();
+    }
 }
 
 void SlideRepository::moveSlide(std::size_t fromIndex, std::size_t toIndex) {
-    if (fromIndex >= slides_.size() || toIndex >= slides_.size()) {
-        throw std::out_of_range("Invalid index for moving slide");
+    mutableSlides().move(fromIndex, toIndex);
+    if (changes_.enabled) {
+        changes_.ops.push_back({ChangeLog::OpType::Move, fromIndex, toIndex});
     }
- 
-    auto slide = std::move(slides_[fromIndex]);
-    slides_.erase(slides_.begin() + fromIndex);
-    slides_.insert(slides_.begin() + toIndex, std::move(slide));
 }
 
 void SlideRepository::removeSlideById(int id) {
-    for (auto it = slides_.begin(); it != slides_.end(); ++it) {
-        if ((*it)->getId() == id) {
-            slides_.erase(it);
-            return;
+    auto it = find(id);
+    if (it == index_.end()) {
+        return;
+    }
+
+    mutableSlides().erase(it->second);
+    index_.erase(it);
+    if (changes_.enabled) {
+        changes_.ops.push_back({ChangeLog::OpType::Remove, 0, 0, id});
+        if (index_.count(id) == 0) {
+            changes_.touched.erase(id);
         }
     }
 }
 
+// Index entry for the first slide in order with `id`, or end(). IDs are
+// looked up as a scan of the sequence would find them, so when one repeats,
+// removing the first slide with it exposes the next.
+std::unordered_multimap<int, SlideSequence::Slot>::const_iterator SlideRepository::find(int id) const {
+    auto [first, last] = index_.equal_range(id);
+    auto found = first;
+    if (first != last && std::next(first) != last) {
+        std::size_t position = slides_->positionOf(first->second);
+        for (auto it = std::next(first); it != last; ++it) {
+            std::size_t candidate = slides_->positionOf(it->second);
+            if (candidate < position) {
+                position = candidate;
+                found = it;
+            }
+        }
+    }
+
+    return found == last ? index_.end() : found;
+}
+
 std::vector<Slide*> SlideRepository::getAllSlides() {
     std::vector<Slide*> result;
-    result.reserve(slides_.size());
-    for (auto& s : slides_) result.push_back(s.get());
+    result.reserve(slides_->size());
+    forEachSlide([&result](Slide& slide, std::size_t) {
+        result.push_back(&slide);
+    });
     return result;
-}
\ No newline at end of file
+}
+
+const ChangeLog& SlideRepository::changes() const {
+    return changes_;
+}
+
+void SlideRepository::markSaved() {
+    changes_.enabled = true;
+    changes_.ops = {};
+    changes_.touched = {};
+}
+
+void SlideRepository::stopChangeLog() {
+    changes_.enabled = false;
+    changes_.ops = {};
+    changes_.touched = {};
+}
+
+// Copy-on-write: the sequence is copied (slide pointers only) the first time
+// it is mutated while a snapshot still references it.
+SlideSequence& SlideRepository::mutableSlides() {
+    if (slides_.use_count() > 1) {
+        slides_ = std::make_shared<SlideSequence>(*slides_);
+    }
+
+    return *slides_;
+}
+
+// Hands out a slide that is safe to modify, cloning it first if a snapshot
+// still shares it. Only slides that are actually touched get copied. The
+// slide's revision is noted so the next incremental save can tell whether
+// the caller really changed it.
+Slide* SlideRepository::writableSlide(SlideSequence::Slot slot) {
+    SlideSequence& slides = mutableSlides();
+    std::shared_ptr<Slide>& slide = slides.holder(slot);
+    if (slide.use_count() > 1) {
+        slide = std::allocate_shared<Slide>(std::pmr::polymorphic_allocator<Slide>(slides.resource()), *slide);
+    }
+    if (changes_.enabled) {
+        changes_.touched.try_emplace(slide->getId(), slide->revision());
+    }
+
+    return slide.get();
+}
@@ -0,0 +1,300 @@
+#include "../../include/core/SlideSequence.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+SlideSequence::SlideSequence() : resource_(std::make_shared<std::pmr::synchronized_pool_resource>()) {}
+
+std::pmr::memory_resource* SlideSequence::resource() const { return resource_.get(); }
+
+// Switches to a fresh resource. The old one is released in one go once no
+// copy of the sequence refers to it any more; callers clear() first.
+void SlideSequence::resetResource() {
+    resource_ = std::make_shared<std::pmr::synchronized_pool_resource>();
+    arenas_.clear();
+}
+
+// Keeps `arena` alive alongside the main resource so slides allocated in it
+// can be stored without being copied over.
+void SlideSequence::adopt(std::shared_ptr<std::pmr::memory_resource> arena) {
+    arenas_.push_back(std::move(arena));
+}
+
+bool SlideSequence::owns(const std::pmr::memory_resource* resource) const {
+    if (resource == resource_.get()) {
+        return true;
+    }
+
+    return std::any_of(arenas_.begin(), arenas_.end(),
+                       [resource](const auto& arena) { return arena.get() == resource; });
+}
+
+std::size_t SlideSequence::size() const { return sizeOf(root_); }
+bool SlideSequence::empty() const { return root_ == npos; }
+
+SlideSequence::Slot SlideSequence::insert(std::size_t position, std::shared_ptr<Slide> slide) {
+    if (position > size()) {
+        throw std::out_of_range("Slide insert position out of range");
+    }
+
+    return link(position, allocate(std::move(slide)));
+}
+
+SlideSequence::Slot SlideSequence::insertLazy(std::size_t position, const std::shared_ptr<const SlideSource>& source,
+                                              std::uint32_t entry) {
+    if (position > size()) {
+        throw std::out_of_range("Slide insert position out of range");
+    }
+    if (sources_.empty() || sources_.back() != source) {
+        sources_.push_back(source);
+    }
+
+    Slot slot = allocate(nullptr);
+    nodes_[slot].source = source.get();
+    nodes_[slot].entry = entry;
+
+    return link(position, slot);
+}
+
+std::shared_ptr<Slide> SlideSequence::erase(Slot slot) {
+    std::size_t position = positionOf(slot);
+    Slot left, middle, right;
+    split(root_, position, left, middle);
+    split(middle, 1, middle, right);
+    root_ = merge(left, right);
+    if (root_ != npos) {
+        nodes_[root_].parent = npos;
+    }
+
+    std::shared_ptr<Slide> slide = std::move(nodes_[slot].slide);
+    release(slot);
+
+    return slide;
+}
+
+void SlideSequence::move(std::size_t fromPosition, std::size_t toPosition) {
+    if (fromPosition >= size() || toPosition >= size()) {
+        throw std::out_of_range("Invalid index for moving slide");
+    }
+
+    Slot left, middle, right;
+    split(root_, fromPosition, left, middle);
+    split(middle, 1, middle, right);
+    Slot rest = merge(left, right);
+    split(rest, toPosition, left, right);
+    root_ = merge(merge(left, middle), right);
+    nodes_[root_].parent = npos;
+}
+
+void SlideSequence::clear() {
+    free_.clear();
+    for (std::size_t i = nodes_.size(); i-- > 0;) {
+        if (nodes_[i].slide || nodes_[i].source) {
+            release(static_cast<Slot>(i));
+        } else {
+            free_.push_back(static_cast<Slot>(i));
+        }
+    }
+    root_ = npos;
+    sources_.clear();
+}
+
+Slide* SlideSequence::get(Slot slot) const {
+    if (slot >= nodes_.size()) {
+        return nullptr;
+    }
+
+    return materialize(nodes_[slot]);
+}
+
+std::shared_ptr<Slide>& SlideSequence::holder(Slot slot) {
+    materialize(nodes_[slot]);
+    return nodes_[slot].slide;
+}
+
+std::uint32_t SlideSequence::generation(Slot slot) const {
+    return nodes_[slot].generation;
+}
+
+SlideSequence::Slot SlideSequence::slotAt(std::size_t position) const {
+    if (position >= size()) {
+        return npos;
+    }
+
+    Slot node = root_;
+    while (true) {
+        std::uint32_t leftSize = sizeOf(nodes_[node].left);
+        if (position < leftSize) {
+            node = nodes_[node].left;
+        } else if (position == leftSize) {
+            return node;
+        } else {
+            position -= leftSize + 1;
+            node = nodes_[node].right;
+        }
+    }
+}
+
+std::size_t SlideSequence::positionOf(Slot slot) const {
+    std::size_t position = sizeOf(nodes_[slot].left);
+    for (Slot node = slot, parent = nodes_[slot].parent; parent != npos; node = parent, parent = nodes_[parent].parent) {
+        if (nodes_[parent].right == node) {
+            position += sizeOf(nodes_[parent].left) + 1;
+        }
+    }
+
+    return position;
+}
+
+SlideSequence::Slot SlideSequence::first() const {
+    Slot node = root_;
+    while (node != npos && nodes_[node].left != npos) {
+        node = nodes_[node].left;
+    }
+
+    return node;
+}
+
+SlideSequence::Slot SlideSequence::next(Slot slot) const {
+    if (nodes_[slot].right != npos) {
+        Slot node = nodes_[slot].right;
+        while (nodes_[node].left != npos) {
+            node = nodes_[node].left;
+        }
+        return node;
+    }
+
+    Slot node = slot;
+    Slot parent = nodes_[node].parent;
+    while (parent != npos && nodes_[parent].right == node) {
+        node = parent;
+        parent = nodes_[parent].parent;
+    }
+
+    return parent;
+}
+
+void SlideSequence::forEach(ConstSlideVisitor visitor) const {
+    std::size_t index = 0;
+    for (Slot slot = first(); slot != npos; slot = next(slot)) {
+        visitor(*materialize(nodes_[slot]), index++);
+    }
+}
+
+// Like forEach(), but slides that were never built are handed to `raw` as
+// their source JSON instead of being materialized.
+void SlideSequence::forEachStored(ConstSlideVisitor visitor, RawSlideVisitor raw) const {
+    forEachStored(0, size(), visitor, raw);
+}
+
+// Visits positions [begin, end) without building lazy slides, so disjoint
+// ranges of one sequence can be walked from several threads at once.
+void SlideSequence::forEachStored(std::size_t begin, std::size_t end, ConstSlideVisitor visitor,
+                                  RawSlideVisitor raw) const {
+    std::size_t index = begin;
+    for (Slot slot = slotAt(begin); slot != npos && index < end; slot = next(slot)) {
+        const Node& node = nodes_[slot];
+        if (node.slide) {
+            visitor(*node.slide, index++);
+        } else {
+            raw(node.source->jsonAt(node.entry), index++);
+        }
+    }
+}
+
+std::uint32_t SlideSequence::sizeOf(Slot slot) const {
+    return slot == npos ? 0 : nodes_[slot].size;
+}
+
+void SlideSequence::update(Slot slot) {
+    Node& node = nodes_[slot];
+    node.size = 1 + sizeOf(node.left) + sizeOf(node.right);
+    if (node.left != npos) nodes_[node.left].parent = slot;
+    if (node.right != npos) nodes_[node.right].parent = slot;
+}
+
+// Splits the subtree rooted at `node` so that its first `count` slides end up
+// in `left` and the rest in `right`.
+void SlideSequence::split(Slot node, std::size_t count, Slot& left, Slot& right) {
+    if (node == npos) {
+        left = right = npos;
+        return;
+    }
+
+    std::uint32_t leftSize = sizeOf(nodes_[node].left);
+    if (count <= leftSize) {
+        split(nodes_[node].left, count, left, nodes_[node].left);
+        right = node;
+    } else {
+        split(nodes_[node].right, count - leftSize - 1, nodes_[node].right, right);
+        left = node;
+    }
+
+    update(node);
+    if (left != npos) nodes_[left].parent = npos;
+    if (right != npos) nodes_[right].parent = npos;
+}
+
+SlideSequence::Slot SlideSequence::merge(Slot left, Slot right) {
+    if (left == npos) return right;
+    if (right == npos) return left;
+
+    if (nodes_[left].priority > nodes_[right].priority) {
+        nodes_[left].right = merge(nodes_[left].right, right);
+        update(left);
+        return left;
+    }
+
+    nodes_[right].left = merge(left, nodes_[right].left);
+    update(right);
+    return right;
+}
+
+SlideSequence::Slot SlideSequence::allocate(std::shared_ptr<Slide> slide) {
+    Slot slot;
+    if (!free_.empty()) {
+        slot = free_.back();
+        free_.pop_back();
+    } else {
+        slot = static_cast<Slot>(nodes_.size());
+        nodes_.emplace_back();
+    }
+
+    Node& node = nodes_[slot];
+    node.slide = std::move(slide);
+    node.priority = nextPriority();
+
+    return slot;
+}
+
+SlideSequence::Slot SlideSequence::link(std::size_t position, Slot slot) {
+    Slot left, right;
+    split(root_, position, left, right);
+    root_ = merge(merge(left, slot), right);
+    nodes_[root_].parent = npos;
+
+    return slot;
+}
+
+Slide* SlideSequence::materialize(const Node& node) const {
+    if (!node.slide && node.source) {
+        std::unique_ptr<Slide> built = node.source->materialize(node.entry, resource());
+        node.slide = std::allocate_shared<Slide>(std::pmr::polymorphic_allocator<Slide>(resource()), std::move(*built));
+    }
+
+    return node.slide.get();
+}
+
+void SlideSequence::release(Slot slot) {
+    std::uint32_t generation = nodes_[slot].generation + 1;
+    nodes_[slot] = Node{};
+    nodes_[slot].generation = generation;
+    free_.push_back(slot);
+}
+
+std::uint32_t SlideSequence::nextPriority() {
+    seed_ ^= seed_ << 13;
+    seed_ ^= seed_ >> 17;
+    seed_ ^= seed_ << 5;
+
+    return seed_;
+}
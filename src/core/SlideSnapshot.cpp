@@ -0,0 +1,74 @@
+#include "../../include/core/SlideSnapshot.hpp"
+#include "../../include/serialization/JsonWriter.hpp"
+#include <iostream>
+
+SlideSnapshot::SlideSnapshot() : slides_(std::make_shared<SlideSequence>()) {}
+
+SlideSnapshot::SlideSnapshot(std::shared_ptr<const SlideSequence> slides) : slides_(std::move(slides)) {}
+
+std::size_t SlideSnapshot::slideCount() const {
+    return slides_->size();
+}
+
+const Slide* SlideSnapshot::getSlideAt(std::size_t index) const {
+    return slides_->get(slides_->slotAt(index));
+}
+
+SlideSnapshot SlideSnapshot::isolated() const {
+    return SlideSnapshot(std::make_shared<const SlideSequence>(*slides_));
+}
+
+void SlideSnapshot::forEachSlide(ConstSlideVisitor visitor) const {
+    slides_->forEach(visitor);
+}
+
+void SlideSnapshot::displayAll() const {
+    forEachSlide([](const Slide& slide, std::size_t) {
+        std::cout << slide.toString() << "-------------------\n";
+    });
+}
+
+nlohmann::json SlideSnapshot::toJson() const {
+    nlohmann::json j;
+    j["language"] = "C++";
+    nlohmann::json slidesJson = nlohmann::json::array();
+    forEachSlide([&slidesJson](const Slide& slide, std::size_t) {
+        slidesJson.push_back(slide.toJson());
+    });
+ 
+    j["slides"] = slidesJson;
+    return j;
+}
+
+// Streaming counterpart of toJson(). Lazily loaded slides that were never
+// touched are copied through from their source text.
+void SlideSnapshot::writeJson(JsonWriter& writer) const {
+    std::size_t count = slideCount();
+    writeJsonHead(writer);
+    writeJsonSlides(writer, 0, count);
+    writeJsonTail(writer, count);
+}
+
+// The slides array sits two containers deep: the document object, which has
+// one member before it, and the array itself.
+void SlideSnapshot::writeJsonHead(JsonWriter& writer) {
+    writer.beginObject();
+    writer.key("language");
+    writer.value("C++");
+    writer.key("slides");
+    writer.beginArray();
+}
+
+void SlideSnapshot::writeJsonSlides(JsonWriter& writer, std::size_t begin, std::size_t end) const {
+    writer.resume(2, begin);
+    slides_->forEachStored(
+        begin, end,
+        [&writer](const Slide& slide, std::size_t) { slide.writeJson(writer); },
+        [&writer](std::string_view json, std::size_t) { writer.raw(json); });
+}
+
+void SlideSnapshot::writeJsonTail(JsonWriter& writer, std::size_t count) {
+    writer.resume(2, count);
+    writer.endArray();
+    writer.endObject();
+}
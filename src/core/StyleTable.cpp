@@ -0,0 +1,43 @@
+#include "../../include/core/StyleTable.hpp"
+#include <mutex>
+#include <stdexcept>
+
+StyleTable::StyleTable() {
+    intern("Arial");
+    intern("Black");
+}
+
+StyleTable& StyleTable::instance() {
+    static StyleTable table;
+    return table;
+}
+
+// Names are nearly always already present, so the lookup runs under a shared
+// lock and only a new name takes the exclusive one.
+StyleId StyleTable::intern(std::string_view name) {
+    {
+        std::shared_lock lock(mutex_);
+        auto it = ids_.find(name);
+        if (it != ids_.end()) return it->second;
+    }
+
+    std::unique_lock lock(mutex_);
+    auto it = ids_.find(name);
+    if (it != ids_.end()) return it->second;
+
+    StyleId id = static_cast<StyleId>(names_.size());
+    names_.emplace_back(name);
+    ids_.emplace(names_.back(), id);
+    return id;
+}
+
+const std::string& StyleTable::name(StyleId id) const {
+    std::shared_lock lock(mutex_);
+    if (id < names_.size()) return names_[id];
+    throw std::out_of_range("Style ID out of range");
+}
+
+std::size_t StyleTable::size() const {
+    std::shared_lock lock(mutex_);
+    return names_.size();
+}
@@ -1,11 +1,60 @@
 #include "../include/CommandFactory.hpp"
 #include "../include/core/SlideRepository.hpp"
+#include "../include/core/SlidePatch.hpp"
 #include "../include/CommandHistory.hpp"
 #include "../include/serialization/SvgSerializer.hpp"
+#include "../include/serialization/SerializerFactory.hpp"
 #include <iostream>
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <optional>
+#include <vector>
+
+// An SVG export as given on the command line or in the command loop:
+// "<output.svg> [--parallel] [--symbols]" or "--split <dir> [--symbols]".
+struct SvgExport {
+    std::string target;
+    bool split = false;
+    bool parallel = false;
+    bool symbols = false;
+};
+
+const char* const svgExportUsage = "export-svg <output.svg> [--parallel] [--symbols] | export-svg --split <dir> [--symbols]";
+
+std::optional<SvgExport> parseSvgExport(const std::vector<std::string>& args) {
+    SvgExport request;
+    std::size_t next = 0;
+    if (!args.empty() && args[0] == "--split") {
+        request.split = true;
+        ++next;
+    }
+    if (next >= args.size() || args[next].rfind("--", 0) == 0) {
+        return std::nullopt;
+    }
+    request.target = args[next++];
+    for (; next < args.size(); ++next) {
+        if (args[next] == "--parallel" && !request.split) {
+            request.parallel = true;
+        } else if (args[next] == "--symbols") {
+            request.symbols = true;
+        } else {
+            return std::nullopt;
+        }
+    }
+    return request;
+}
+
+void runSvgExport(const ISlideView& view, const SvgExport& request) {
+    SvgSerializer svgSerializer(request.symbols);
+    if (request.split) {
+        svgSerializer.saveSplit(view, request.target);
+    } else if (request.parallel) {
+        svgSerializer.saveParallel(view, request.target);
+    } else {
+        svgSerializer.save(view, request.target);
+    }
+}
 
 void runSlideEditor(std::istream& input) {
     SlideFactory slideFactory;
@@ -14,11 +63,12 @@ void runSlideEditor(std::istream& input) {
     CommandFactory cmdFactory(slideFactory, repo, serializer);
     CommandHistory history;
 
-    std::cout << "SlideEditor CLI - Commands: create <title> <content> <theme>, addtext <id> <text> --size <float> [--font <font>] [--color <color>] [--line-width <float>], addshape <id> <type> <scale>, move <from> <to>, removetext <id> <index>, removeshape <id> <index>, save <file>, load <file>, export-svg <output.svg>, display, help [command], exit" << std::endl;
+    std::cout << "SlideEditor CLI - Commands: create <title> <content> <theme>, addtext <id> <text> --size <float> [--font <font>] [--color <color>] [--line-width <float>], addshape <id> <type> <scale>, move <from> <to>, removetext <id> <index>, removeshape <id> <index>, save <file>, load <file>, export-svg <output.svg> [--parallel] [--symbols], export-svg --split <dir> [--symbols], display, help [command], exit" << std::endl;
     std::cout << "Note: For simplicity, assume no spaces in arguments except between tokens. Use 'help' for details." << std::endl;
 
     std::string command;
     while (std::getline(input, command)) {
+        serializer.reportSaves();
         if (command.empty()) {
             cmdFactory.displayHelp();
             continue;
@@ -41,17 +91,18 @@ void runSlideEditor(std::istream& input) {
         iss >> firstArg;
         
         if (firstArg == "export-svg") {
-            std::string outputFile;
-            iss >> outputFile;
-            if (outputFile.empty()) {
-                std::cerr << "Usage: export-svg <output.svg>" << std::endl;
-            } else {
+            std::vector<std::string> args;
+            for (std::string arg; iss >> arg;) {
+                args.push_back(arg);
+            }
+            if (auto request = parseSvgExport(args)) {
                 try {
-                    SvgSerializer svgSerializer;
-                    svgSerializer.save(repo, outputFile);
+                    runSvgExport(repo, *request);
                 } catch (const std::exception& e) {
                     std::cerr << "Error exporting SVG: " << e.what() << std::endl;
                 }
+            } else {
+                std::cerr << "Usage: " << svgExportUsage << std::endl;
             }
             continue;
         }
@@ -62,23 +113,123 @@ void runSlideEditor(std::istream& input) {
             history.pushExecuted(std::move(cmd));
         }
     }
+    serializer.waitForSaves();
+}
+
+// Loads `inputFile` in the format its extension names (JSON by default).
+// Returns false, having printed why, if it could not be loaded.
+bool loadByExtension(ISlideRepository& repo, SlideFactory& factory, const std::string& inputFile) {
+    if (auto serializer = SerializerFactory::forFile(inputFile)) {
+        return serializer->load(repo, factory, inputFile);
+    }
+    return JsonSerializer().load(repo, factory, inputFile);
+}
+
+// Saves `repo` to `outputFile` in the format its extension names.
+void saveByExtension(const ISlideRepository& repo, const std::string& outputFile) {
+    if (auto serializer = SerializerFactory::forFile(outputFile)) {
+        serializer->save(repo, outputFile);
+    } else {
+        JsonSerializer().save(repo, outputFile);
+    }
 }
 
 int main(int argc, char* argv[]) {
-    if (argc == 4 && std::string(argv[1]) == "--export-svg") {
+    // --export-svg <in> followed by the arguments of export-svg.
+    if (argc >= 4 && std::string(argv[1]) == "--export-svg") {
+        std::string inputFile = argv[2];
+        auto request = parseSvgExport(std::vector<std::string>(argv + 3, argv + argc));
+        if (!request) {
+            std::cerr << "Usage: SlideEditor --export-svg <in> (<output.svg> [--parallel] | --split <dir>) [--symbols]"
+                      << std::endl;
+            return 1;
+        }
+
+        try {
+            SlideFactory slideFactory;
+            SlideRepository repo;
+
+            if (!loadByExtension(repo, slideFactory, inputFile)) {
+                return 1;
+            }
+            runSvgExport(repo, *request);
+
+            return 0;
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    // Converts between presentation formats, each chosen by file extension.
+    if (argc == 4 && std::string(argv[1]) == "--convert") {
         std::string inputFile = argv[2];
         std::string outputFile = argv[3];
-        
+
         try {
             SlideFactory slideFactory;
             SlideRepository repo;
-            JsonSerializer jsonSerializer;
-            SvgSerializer svgSerializer;
-            
-            jsonSerializer.load(repo, slideFactory, inputFile);
-            
-            svgSerializer.save(repo, outputFile);
-            
+
+            if (!loadByExtension(repo, slideFactory, inputFile)) {
+                return 1;
+            }
+            saveByExtension(repo, outputFile);
+
+            return 0;
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    // Writes the changes that turn one presentation into another.
+    if (argc == 5 && std::string(argv[1]) == "--diff") {
+        std::string patchFile = argv[4];
+
+        try {
+            SlideFactory slideFactory;
+            SlideRepository from;
+            SlideRepository to;
+
+            if (!loadByExtension(from, slideFactory, argv[2]) || !loadByExtension(to, slideFactory, argv[3])) {
+                return 1;
+            }
+            SlidePatch patch = SlidePatch::diff(from, to);
+
+            std::ofstream out(patchFile);
+            out << patch.toJson().dump() << '\n';
+            out.close();
+            if (!out) {
+                std::cerr << "Error: Cannot write " << patchFile << std::endl;
+                return 1;
+            }
+            std::cout << "Wrote " << patch.changeCount() << " changes to " << patchFile << std::endl;
+            return 0;
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    // Applies a patch written by --diff and saves the result.
+    if (argc == 5 && std::string(argv[1]) == "--patch") {
+        std::string patchFile = argv[3];
+
+        try {
+            SlideFactory slideFactory;
+            SlideRepository repo;
+
+            if (!loadByExtension(repo, slideFactory, argv[2])) {
+                return 1;
+            }
+            std::ifstream in(patchFile);
+            if (!in.is_open()) {
+                std::cerr << "Error: Cannot open file " << patchFile << std::endl;
+                return 1;
+            }
+            SlidePatch::fromJson(nlohmann::json::parse(in)).apply(repo, slideFactory);
+            saveByExtension(repo, argv[4]);
+
             return 0;
         } catch (const std::exception& e) {
             std::cerr << "Error: " << e.what() << std::endl;
@@ -43,5 +43,6 @@ bool Lexer::isFloat(const std::string& str) const {
 }
 
 bool Lexer::isFlag(const std::string& str) const {
-    return str == "--font" || str == "--color" || str == "--size" || str == "--line-width";
+    return str == "--font" || str == "--color" || str == "--size" || str == "--line-width" || str == "--compact" ||
+           str == "--journal" || str == "--lazy" || str == "--parallel" || str == "--async";
 }
\ No newline at end of file
@@ -23,6 +23,7 @@ std::unique_ptr<ICommand> Parser::parse(std::istream& input) const {
     float size = 0.0f, scale = 0.0f, lineWidth = 1.0f;
     std::size_t index = 0, fromIndex = 0, toIndex = 0;
     std::string shapeType, filepath, helpCommand;
+    bool compact = false, journal = false, parallel = false, async = false, lazy = false;
 
     for (std::size_t i = 0; i < tokens.size(); ++i) {
         const auto& token = tokens[i];
@@ -319,7 +320,26 @@ std::unique_ptr<ICommand> Parser::parse(std::istream& input) const {
             case State::SAVE_FILE:
                 if (token.type == Token::Type::Word) {
                     filepath = token.value;
-                    return std::make_unique<SaveCommand>(serializer_, repo_, filepath);
+                    state = State::SAVE_FLAG;
+                } 
+                else {
+                    state = State::ERROR;
+                }
+                
+                break;
+
+            case State::SAVE_FLAG:
+                if (token.type == Token::Type::Flag && token.value == "--compact") {
+                    compact = true;
+                } 
+                else if (token.type == Token::Type::Flag && token.value == "--journal") {
+                    journal = true;
+                } 
+                else if (token.type == Token::Type::Flag && token.value == "--parallel") {
+                    parallel = true;
+                } 
+                else if (token.type == Token::Type::Flag && token.value == "--async") {
+                    async = true;
                 } 
                 else {
                     state = State::ERROR;
@@ -330,7 +350,20 @@ std::unique_ptr<ICommand> Parser::parse(std::istream& input) const {
             case State::LOAD_FILE:
                 if (token.type == Token::Type::Word) {
                     filepath = token.value;
-                    return std::make_unique<LoadCommand>(serializer_, repo_, slideFactory_, filepath);
+                    state = State::LOAD_FLAG;
+                } 
+                else {
+                    state = State::ERROR;
+                }
+                
+                break;
+
+            case State::LOAD_FLAG:
+                if (token.type == Token::Type::Flag && token.value == "--lazy") {
+                    lazy = true;
+                } 
+                else if (token.type == Token::Type::Flag && token.value == "--parallel") {
+                    parallel = true;
                 } 
                 else {
                     state = State::ERROR;
@@ -366,6 +399,22 @@ std::unique_ptr<ICommand> Parser::parse(std::istream& input) const {
         displayHelp();
         return nullptr;
     } 
+    else if (state == State::SAVE_FLAG) {
+        // --compact combines with --parallel or --async; --journal writes its own format.
+        if ((journal && (compact || parallel || async)) || (parallel && async)) {
+            std::cout << "Conflicting save flags: --journal stands alone, and --parallel and --async exclude each other."
+                      << std::endl;
+            return nullptr;
+        }
+        return std::make_unique<SaveCommand>(serializer_, repo_, filepath, compact, journal, parallel, async);
+    } 
+    else if (state == State::LOAD_FLAG) {
+        if (lazy && parallel) {
+            std::cout << "Conflicting load flags: --lazy and --parallel exclude each other." << std::endl;
+            return nullptr;
+        }
+        return std::make_unique<LoadCommand>(serializer_, repo_, slideFactory_, filepath, lazy, parallel);
+    } 
     else if (state == State::ADDTEXT_FONT_FLAG || state == State::ADDTEXT_COLOR_FLAG || state == State::ADDTEXT_LINEWIDTH_FLAG) {
         return std::make_unique<AddTextCommand>(repo_, slideId, textContent, size, font, color, lineWidth);
     }
@@ -383,8 +432,8 @@ void Parser::displayHelp(const std::string& command) const {
                   << "  move <from> <to> - Move slide from index to another\n"
                   << "  removetext <id> <index> - Remove text from a slide\n"
                   << "  removeshape <id> <index> - Remove a shape from a slide\n"
-                  << "  save <file> - Save presentation to file\n"
-                  << "  load <file> - Load presentation from file\n"
+                  << "  save <file> [--compact] [--parallel | --async] | save <file> --journal - Save presentation to file\n"
+                  << "  load <file> [--lazy | --parallel] - Load presentation from file\n"
                   << "  display - Display all slides\n"
                   << "  help [command] - Show this help or command details\n"
                   << "  exit - Exit the program\n"
@@ -425,14 +474,21 @@ void Parser::displayHelp(const std::string& command) const {
                   << "  No flags available.\n";
     } 
     else if (command == "save") {
-        std::cout << "save <file>\n"
+        std::cout << "save <file> [--compact] [--parallel | --async] | save <file> --journal\n"
                   << "  Saves the presentation to <file> in JSON format.\n"
-                  << "  No flags available.\n";
+                  << "  Flags:\n"
+                  << "    --compact        : Optional. Writes without indentation or line breaks.\n"
+                  << "    --journal        : Optional. Appends only the changes since the last save to <file>.journal.\n"
+                  << "    --parallel       : Optional. Serializes slides on one thread per core; same output.\n"
+                  << "    --async          : Optional. Saves in the background and returns at once; the result is\n"
+                  << "                       reported before a later command. The file is replaced only when complete.\n";
     } 
     else if (command == "load") {
-        std::cout << "load <file>\n"
+        std::cout << "load <file> [--lazy | --parallel]\n"
                   << "  Loads the presentation from <file>.\n"
-                  << "  No flags available.\n";
+                  << "  Flags:\n"
+                  << "    --lazy           : Optional. Indexes a JSON file and builds each slide on first use.\n"
+                  << "    --parallel       : Optional. Parses the slides of a JSON file on one thread per core.\n";
     } 
     else if (command == "display") {
         std::cout << "display\n"
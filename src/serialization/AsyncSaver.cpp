@@ -0,0 +1,109 @@
+#include "../../include/serialization/AsyncSaver.hpp"
+#include "../../include/serialization/AtomicFile.hpp"
+#include <system_error>
+
+AsyncSaver::~AsyncSaver() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void AsyncSaver::submit(const std::string& filepath, Writer writer, const std::string& obsolete) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        bool replaced = false;
+        for (auto& job : jobs_) {
+            if (job.filepath == filepath) {
+                job.writer = std::move(writer);
+                job.obsolete = obsolete;
+                replaced = true;
+                break;
+            }
+        }
+        if (!replaced) {
+            jobs_.push_back({filepath, std::move(writer), obsolete});
+        }
+    }
+
+    if (!thread_.joinable()) {
+        try {
+            thread_ = std::thread(&AsyncSaver::run, this, true);
+        } catch (const std::system_error&) {
+            // No thread to hand the save to: run the queue here instead.
+            run(false);
+            return;
+        }
+    }
+    wake_.notify_one();
+}
+
+// Finished jobs are destroyed here, on the caller's thread, once the lock
+// is released.
+std::vector<std::string> AsyncSaver::takeReports() {
+    std::vector<Job> finished;
+    std::vector<std::string> reports;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished.swap(finished_);
+        reports.swap(reports_);
+    }
+    return reports;
+}
+
+void AsyncSaver::wait() {
+    std::vector<Job> finished;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this] { return jobs_.empty() && !busy_; });
+        finished.swap(finished_);
+    }
+}
+
+// On the background thread, waits for work until the saver is destroyed.
+// Otherwise (the fallback in submit()) drains the queue and returns.
+void AsyncSaver::run(bool background) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        if (background) {
+            wake_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+        }
+        if (jobs_.empty()) {
+            return;
+        }
+
+        Job job = std::move(jobs_.front());
+        jobs_.pop_front();
+        busy_ = true;
+        lock.unlock();
+        std::string report = save(job);
+        lock.lock();
+        busy_ = false;
+        finished_.push_back(std::move(job));
+        reports_.push_back(std::move(report));
+        if (jobs_.empty()) {
+            idle_.notify_all();
+        }
+    }
+}
+
+std::string AsyncSaver::save(const Job& job) {
+    try {
+        AtomicFile file(job.filepath);
+        if (!file.isOpen()) {
+            return "Error: Cannot open file " + job.filepath;
+        }
+        job.writer(file.stream());
+        if (!file.commit(job.obsolete)) {
+            return "Error saving to " + job.filepath + ": write failed";
+        }
+    } catch (const std::exception& e) {
+        return "Error saving to " + job.filepath + ": " + e.what();
+    }
+
+    return "Saved presentation to " + job.filepath;
+}
@@ -0,0 +1,79 @@
+#include "../../include/serialization/AtomicFile.hpp"
+#include <cstdio>
+#include <filesystem>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Flushes a file's or directory's contents to disk. Without fsync the
+// rename can reach the disk before the data it points at.
+bool syncToDisk(const std::string& path) {
+#if defined(_WIN32)
+    (void)path;
+    return true;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    return synced;
+#endif
+}
+
+}
+
+AtomicFile::AtomicFile(const std::string& filepath)
+    : filepath_(filepath), tempPath_(filepath + ".tmp"), file_(tempPath_, std::ios::binary) {
+    pending_ = file_.is_open();
+}
+
+AtomicFile::~AtomicFile() {
+    if (pending_) {
+        file_.close();
+        std::remove(tempPath_.c_str());
+    }
+}
+
+bool AtomicFile::isOpen() const { return file_.is_open(); }
+std::ostream& AtomicFile::stream() { return file_; }
+
+bool AtomicFile::commit(const std::string& obsolete, bool durable) {
+    if (!pending_) {
+        return false;
+    }
+
+    pending_ = false;
+    file_.close();
+    if (!file_) {
+        std::remove(tempPath_.c_str());
+        return false;
+    }
+    return replace(tempPath_, filepath_, obsolete, durable);
+}
+
+bool AtomicFile::replace(const std::string& tempPath, const std::string& filepath, const std::string& obsolete,
+                         bool durable) {
+    if (durable && !syncToDisk(tempPath)) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    if (std::rename(tempPath.c_str(), filepath.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+    if (durable) {
+        // Make the rename itself durable. Some file systems cannot sync a
+        // directory; the file is in place either way.
+        std::filesystem::path directory = std::filesystem::path(filepath).parent_path();
+        syncToDisk(directory.empty() ? "." : directory.string());
+    }
+    if (!obsolete.empty()) {
+        std::remove(obsolete.c_str());
+    }
+    return true;
+}
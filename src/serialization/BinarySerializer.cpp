@@ -0,0 +1,316 @@
+#include "../../include/serialization/BinarySerializer.hpp"
+#include "../../include/serialization/AtomicFile.hpp"
+#include "../../include/serialization/MappedFile.hpp"
+#include "../../include/serialization/SerializerFactory.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+namespace {
+
+constexpr char magic[4] = {'S', 'L', 'D', 'B'};
+constexpr std::size_t headerSize = 32;
+constexpr std::size_t textRecordSize = 20;
+constexpr std::size_t shapeRecordSize = 8;
+constexpr std::size_t bodySize = 28;
+constexpr std::size_t slideEntrySize = 16;
+
+void putU32(std::string& out, std::uint32_t v) {
+    char bytes[4] = {static_cast<char>(v), static_cast<char>(v >> 8), static_cast<char>(v >> 16), static_cast<char>(v >> 24)};
+    out.append(bytes, 4);
+}
+
+void putU64(std::string& out, std::uint64_t v) {
+    putU32(out, static_cast<std::uint32_t>(v));
+    putU32(out, static_cast<std::uint32_t>(v >> 32));
+}
+
+void putF32(std::string& out, float f) {
+    std::uint32_t v;
+    std::memcpy(&v, &f, sizeof(v));
+    putU32(out, v);
+}
+
+// Assigns each distinct string an ID in first-seen order. Keys view strings
+// owned by the slides or the StyleTable, which outlive the save.
+class StringTable {
+public:
+    std::uint32_t id(std::string_view str) {
+        auto [it, inserted] = ids_.emplace(str, static_cast<std::uint32_t>(strings_.size()));
+        if (inserted) strings_.push_back(str);
+        return it->second;
+    }
+
+    const std::vector<std::string_view>& strings() const { return strings_; }
+
+private:
+    std::unordered_map<std::string_view, std::uint32_t> ids_;
+    std::vector<std::string_view> strings_;
+};
+
+// Bounds-checked little-endian reads from the mapping. Any offset or length
+// that points outside the file is reported as a corrupt file.
+class Reader {
+public:
+    Reader(const char* data, std::size_t size) : data_(data), size_(size) {}
+
+    void require(std::uint64_t offset, std::uint64_t length) const {
+        if (offset > size_ || length > size_ - offset) {
+            throw std::runtime_error("Corrupt binary presentation: offset out of range");
+        }
+    }
+
+    std::uint32_t u32(std::uint64_t offset) const {
+        require(offset, 4);
+        const auto* p = reinterpret_cast<const unsigned char*>(data_ + offset);
+        return static_cast<std::uint32_t>(p[0]) | static_cast<std::uint32_t>(p[1]) << 8 |
+               static_cast<std::uint32_t>(p[2]) << 16 | static_cast<std::uint32_t>(p[3]) << 24;
+    }
+
+    std::uint64_t u64(std::uint64_t offset) const {
+        return static_cast<std::uint64_t>(u32(offset)) | static_cast<std::uint64_t>(u32(offset + 4)) << 32;
+    }
+
+    float f32(std::uint64_t offset) const {
+        std::uint32_t v = u32(offset);
+        float f;
+        std::memcpy(&f, &v, sizeof(f));
+        return f;
+    }
+
+    std::uint8_t u8(std::uint64_t offset) const {
+        require(offset, 1);
+        return static_cast<std::uint8_t>(data_[offset]);
+    }
+
+    std::string_view bytes(std::uint64_t offset, std::uint64_t length) const {
+        require(offset, length);
+        return std::string_view(data_ + offset, static_cast<std::size_t>(length));
+    }
+
+private:
+    const char* data_;
+    std::size_t size_;
+};
+
+}
+
+bool BinarySerializer::handles(const std::string& filepath) {
+    return SerializerFactory::hasExtension(filepath, ".sbin");
+}
+
+// Text runs, shape runs and slide bodies are interned by their encoded
+// bytes. The encoding refers to strings by ID, so equal elements encode to
+// equal bytes, and each distinct run or body is written once however many
+// slides use it.
+void BinarySerializer::write(const ISlideView& view, std::ostream& out) const {
+    StringTable strings;
+    std::string records;
+    std::unordered_map<std::string, std::uint64_t> interned;
+    std::vector<std::pair<std::uint32_t, std::uint64_t>> slideEntries;
+    slideEntries.reserve(view.slideCount());
+
+    std::string scratch;
+    auto intern = [&]() {
+        auto [it, inserted] = interned.try_emplace(scratch, records.size());
+        if (inserted) records.append(scratch);
+        scratch.clear();
+        return it->second;
+    };
+
+    view.forEachSlide([&](const Slide& slide, std::size_t) {
+        putU32(scratch, static_cast<std::uint32_t>(slide.getTexts().size()));
+        for (const auto& text : slide.getTexts()) {
+            putU32(scratch, strings.id(text.content));
+            putU32(scratch, strings.id(text.fontName()));
+            putU32(scratch, strings.id(text.colorName()));
+            putF32(scratch, text.size);
+            putF32(scratch, text.lineWidth);
+        }
+        std::uint64_t textRun = intern();
+
+        putU32(scratch, static_cast<std::uint32_t>(slide.getShapes().size()));
+        for (const auto& shape : slide.getShapes()) {
+            scratch.push_back(static_cast<char>(shape.getKind()));
+            scratch.append(3, '\0');
+            putF32(scratch, shape.getScale());
+        }
+        std::uint64_t shapeRun = intern();
+
+        putU32(scratch, strings.id(slide.titleView()));
+        putU32(scratch, strings.id(slide.contentView()));
+        putU32(scratch, strings.id(slide.themeView()));
+        putU64(scratch, textRun);
+        putU64(scratch, shapeRun);
+        slideEntries.emplace_back(static_cast<std::uint32_t>(slide.getId()), intern());
+    });
+
+    std::string blob;
+    std::vector<std::uint64_t> stringOffsets;
+    stringOffsets.reserve(strings.strings().size());
+    for (std::string_view str : strings.strings()) {
+        stringOffsets.push_back(headerSize + blob.size());
+        putU32(blob, static_cast<std::uint32_t>(str.size()));
+        blob.append(str);
+    }
+
+    std::uint64_t stringTableOffset = headerSize + blob.size();
+    std::uint64_t recordsOffset = stringTableOffset + 8 * stringOffsets.size();
+    std::uint64_t slideTableOffset = recordsOffset + records.size();
+
+    std::string header(magic, sizeof(magic));
+    putU32(header, version);
+    putU32(header, static_cast<std::uint32_t>(slideEntries.size()));
+    putU32(header, static_cast<std::uint32_t>(stringOffsets.size()));
+    putU64(header, stringTableOffset);
+    putU64(header, slideTableOffset);
+
+    std::string stringTable;
+    for (std::uint64_t offset : stringOffsets) putU64(stringTable, offset);
+    std::string tail;
+    for (const auto& [id, body] : slideEntries) {
+        putU32(tail, id);
+        putU32(tail, 0);
+        putU64(tail, body);
+    }
+
+    out.write(header.data(), static_cast<std::streamsize>(header.size()));
+    out.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+    out.write(stringTable.data(), static_cast<std::streamsize>(stringTable.size()));
+    out.write(records.data(), static_cast<std::streamsize>(records.size()));
+    out.write(tail.data(), static_cast<std::streamsize>(tail.size()));
+}
+
+void BinarySerializer::save(const ISlideView& view, const std::string& filepath) const {
+    try {
+        AtomicFile file(filepath);
+        if (!file.isOpen()) {
+            std::cout << "Error: Cannot open file " << filepath << std::endl;
+            return;
+        }
+
+        write(view, file.stream());
+        if (!file.commit()) {
+            std::cout << "Error saving to " << filepath << ": write failed" << std::endl;
+            return;
+        }
+        std::cout << "Saved presentation to " << filepath << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "Error saving to " << filepath << ": " << e.what() << std::endl;
+    }
+}
+
+// Slides are read body by body: the first slide with a given body decodes
+// it, later ones copy that slide under their own ID. Text runs are likewise
+// decoded once and then copied, which also skips interning their font and
+// color names again. Every slide is an independent object.
+void BinarySerializer::read(ISlideRepository& repo, SlideFactory& factory, std::string_view data) {
+    std::vector<std::unique_ptr<Slide>> slides;
+    int maxId = 1;
+    Reader in(data.data(), data.size());
+
+    in.require(0, headerSize);
+    if (std::memcmp(data.data(), magic, sizeof(magic)) != 0) {
+        throw std::runtime_error("Invalid binary format");
+    }
+    if (in.u32(4) != version) {
+        throw std::runtime_error("Unsupported binary format version");
+    }
+
+    std::uint32_t slideCount = in.u32(8);
+    std::uint32_t stringCount = in.u32(12);
+    std::uint64_t stringTableOffset = in.u64(16);
+    std::uint64_t slideTableOffset = in.u64(24);
+    in.require(stringTableOffset, 8ull * stringCount);
+    in.require(slideTableOffset, slideEntrySize * slideCount);
+    std::uint64_t recordsOffset = stringTableOffset + 8ull * stringCount;
+
+    auto string = [&](std::uint32_t id) {
+        if (id >= stringCount) throw std::runtime_error("Corrupt binary presentation: bad string ID");
+        std::uint64_t offset = in.u64(stringTableOffset + 8ull * id);
+        return in.bytes(offset + 4, in.u32(offset));
+    };
+
+    Slide::allocator_type alloc(repo.slideResource());
+    auto addTexts = [&](Slide& slide, std::uint64_t record, std::uint32_t count) {
+        for (std::uint32_t t = 0; t < count; ++t, record += textRecordSize) {
+            Text text(alloc);
+            text.content = string(in.u32(record));
+            text.setFont(string(in.u32(record + 4)));
+            text.setColor(string(in.u32(record + 8)));
+            text.size = in.f32(record + 12);
+            text.lineWidth = in.f32(record + 16);
+            slide.addText(std::move(text));
+        }
+    };
+    auto addShapes = [&](Slide& slide, std::uint64_t record, std::uint32_t count) {
+        for (std::uint32_t s = 0; s < count; ++s, record += shapeRecordSize) {
+            std::uint8_t kind = in.u8(record);
+            if (kind > static_cast<std::uint8_t>(ShapeKind::Ellipse)) {
+                throw std::runtime_error("Corrupt binary presentation: bad shape kind");
+            }
+            slide.addShape(Shape(static_cast<ShapeKind>(kind), in.f32(record + 4)));
+        }
+    };
+
+    // Body and text run offset -> the first slide decoded from it.
+    std::unordered_map<std::uint64_t, std::size_t> bodies;
+    std::unordered_map<std::uint64_t, std::size_t> textRuns;
+
+    slides.reserve(slideCount);
+    for (std::uint32_t i = 0; i < slideCount; ++i) {
+        std::uint64_t entry = slideTableOffset + slideEntrySize * i;
+        int id = static_cast<int>(in.u32(entry));
+        std::uint64_t body = recordsOffset + in.u64(entry + 8);
+        maxId = std::max(maxId, id + 1);
+        if (auto seen = bodies.find(body); seen != bodies.end()) {
+            slides.push_back(std::make_unique<Slide>(id, *slides[seen->second], alloc));
+            continue;
+        }
+
+        in.require(body, bodySize);
+        std::uint64_t textRun = recordsOffset + in.u64(body + 12);
+        std::uint64_t shapeRun = recordsOffset + in.u64(body + 20);
+        std::uint32_t textCount = in.u32(textRun);
+        std::uint32_t shapeCount = in.u32(shapeRun);
+        in.require(textRun + 4, textRecordSize * textCount);
+        in.require(shapeRun + 4, shapeRecordSize * shapeCount);
+
+        auto slide = std::make_unique<Slide>(id, string(in.u32(body)), string(in.u32(body + 4)),
+                                             string(in.u32(body + 8)), alloc);
+        slide->reserve(textCount, shapeCount);
+        if (auto seen = textRuns.find(textRun); seen != textRuns.end()) {
+            for (const auto& text : slides[seen->second]->getTexts()) {
+                slide->addText(text);
+            }
+        } else {
+            addTexts(*slide, textRun + 4, textCount);
+            textRuns.emplace(textRun, slides.size());
+        }
+        addShapes(*slide, shapeRun + 4, shapeCount);
+        bodies.emplace(body, slides.size());
+        slides.push_back(std::move(slide));
+    }
+
+    for (auto& slide : slides) {
+        repo.addSlide(std::move(slide));
+    }
+    factory.resetId(maxId);
+}
+
+bool BinarySerializer::load(ISlideRepository& repo, SlideFactory& factory, const std::string& filepath) {
+    try {
+        MappedFile file(filepath);
+        read(repo, factory, file.view());
+    } catch (const std::exception& e) {
+        std::cout << "Error loading " << filepath << ": " << e.what() << std::endl;
+        return false;
+    }
+    std::cout << "Loaded presentation from " << filepath << std::endl;
+    return true;
+}
@@ -0,0 +1,244 @@
+#include "../../include/serialization/CompressedSerializer.hpp"
+#include "../../include/serialization/AtomicFile.hpp"
+#include "../../include/serialization/LzCodec.hpp"
+#include "../../include/serialization/MappedFile.hpp"
+#include "../../include/serialization/SerializerFactory.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <streambuf>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr char magic[4] = {'S', 'L', 'Z', '1'};
+constexpr std::size_t headerSize = 8;
+constexpr std::size_t blockHeaderSize = 8;
+constexpr std::uint32_t storedRaw = 0x80000000u;
+// Largest block size a file may declare; bounds what a corrupt header can
+// make the loader allocate per block.
+constexpr std::uint32_t maxBlockSize = 16 * 1024 * 1024;
+
+void putU32(char* out, std::uint32_t v) {
+    out[0] = static_cast<char>(v);
+    out[1] = static_cast<char>(v >> 8);
+    out[2] = static_cast<char>(v >> 16);
+    out[3] = static_cast<char>(v >> 24);
+}
+
+std::uint32_t getU32(const char* in) {
+    const auto* p = reinterpret_cast<const unsigned char*>(in);
+    return static_cast<std::uint32_t>(p[0]) | static_cast<std::uint32_t>(p[1]) << 8 |
+           static_cast<std::uint32_t>(p[2]) << 16 | static_cast<std::uint32_t>(p[3]) << 24;
+}
+
+// Runs task(0) .. task(count - 1) on up to `threads` threads, the calling
+// thread included. Tasks must not throw.
+template <typename Task>
+void runParallel(std::size_t count, unsigned threads, Task task) {
+    std::size_t threadCount = std::min<std::size_t>(threads, count);
+    auto work = [&](std::size_t worker) {
+        for (std::size_t i = worker; i < count; i += threadCount) task(i);
+    };
+
+    std::vector<std::thread> started;
+    try {
+        for (std::size_t worker = 1; worker < threadCount; ++worker) {
+            started.emplace_back(work, worker);
+        }
+    } catch (const std::system_error&) {
+        // Workers without a thread are run here below.
+    }
+    if (threadCount > 0) work(0);
+    for (auto& thread : started) {
+        thread.join();
+    }
+    for (std::size_t worker = started.size() + 1; worker < threadCount; ++worker) {
+        work(worker);
+    }
+}
+
+// Stream buffer the wrapped format writes into. It holds one block per
+// thread; when they are all full, the batch is compressed in parallel and
+// written out in order, so memory use does not grow with the presentation.
+class BlockWriter : public std::streambuf {
+public:
+    BlockWriter(std::ostream& out, unsigned threads)
+        : out_(out), threads_(threads), raw_(std::size_t(threads) * CompressedSerializer::blockSize),
+          packed_(threads, std::vector<char>(blockHeaderSize + LzCodec::bound(CompressedSerializer::blockSize))) {
+        char header[headerSize];
+        std::memcpy(header, magic, sizeof(magic));
+        putU32(header + 4, CompressedSerializer::blockSize);
+        out_.write(header, sizeof(header));
+        setp(raw_.data(), raw_.data() + raw_.size());
+    }
+
+    // Writes the last, possibly partial, batch and the end marker.
+    void finish() {
+        writeBatch();
+        char end[4];
+        putU32(end, 0);
+        out_.write(end, sizeof(end));
+    }
+
+protected:
+    int_type overflow(int_type ch) override {
+        writeBatch();
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+private:
+    void writeBatch() {
+        std::size_t filled = static_cast<std::size_t>(pptr() - pbase());
+        std::size_t blocks = (filled + CompressedSerializer::blockSize - 1) / CompressedSerializer::blockSize;
+        std::vector<std::size_t> sizes(blocks);
+
+        runParallel(blocks, threads_, [&](std::size_t block) {
+            const char* raw = raw_.data() + block * CompressedSerializer::blockSize;
+            std::size_t rawSize = std::min<std::size_t>(CompressedSerializer::blockSize,
+                                                        filled - block * CompressedSerializer::blockSize);
+            char* packed = packed_[block].data();
+            std::size_t stored = LzCodec::compress(raw, rawSize, packed + blockHeaderSize);
+            std::uint32_t storedField = static_cast<std::uint32_t>(stored);
+            if (stored >= rawSize) {
+                // Incompressible: keep the block as it is.
+                std::memcpy(packed + blockHeaderSize, raw, rawSize);
+                stored = rawSize;
+                storedField = static_cast<std::uint32_t>(rawSize) | storedRaw;
+            }
+            putU32(packed, static_cast<std::uint32_t>(rawSize));
+            putU32(packed + 4, storedField);
+            sizes[block] = blockHeaderSize + stored;
+        });
+
+        for (std::size_t block = 0; block < blocks; ++block) {
+            out_.write(packed_[block].data(), static_cast<std::streamsize>(sizes[block]));
+        }
+        setp(raw_.data(), raw_.data() + raw_.size());
+    }
+
+    std::ostream& out_;
+    unsigned threads_;
+    std::vector<char> raw_;
+    std::vector<std::vector<char>> packed_;
+};
+
+}
+
+bool CompressedSerializer::handles(const std::string& filepath) {
+    return SerializerFactory::hasExtension(filepath, ".slz");
+}
+
+CompressedSerializer::CompressedSerializer(std::unique_ptr<ISerializer> inner, unsigned workers)
+    : inner_(std::move(inner)), workers_(workers) {}
+
+unsigned CompressedSerializer::threadCount() const {
+    if (workers_ != 0) return workers_;
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void CompressedSerializer::write(const ISlideView& view, std::ostream& out) const {
+    BlockWriter blocks(out, threadCount());
+    std::ostream stream(&blocks);
+    inner_->write(view, stream);
+    if (!stream) throw std::runtime_error("write failed");
+    blocks.finish();
+}
+
+void CompressedSerializer::read(ISlideRepository& repo, SlideFactory& factory, std::string_view data) {
+    struct Block {
+        const char* stored;
+        std::size_t storedSize;
+        std::size_t rawSize;
+        std::size_t offset;
+        bool compressed;
+    };
+
+    if (data.size() < headerSize || std::memcmp(data.data(), magic, sizeof(magic)) != 0) {
+        throw std::runtime_error("Invalid compressed format");
+    }
+    std::uint32_t maxBlock = getU32(data.data() + 4);
+    if (maxBlock > maxBlockSize) throw std::runtime_error("Corrupt compressed presentation: bad block size");
+
+    // Block sizes are all in the headers, so every block's place in the
+    // output is known before any of them is decompressed.
+    std::vector<Block> blocks;
+    std::size_t total = 0;
+    std::size_t at = headerSize;
+    for (;;) {
+        if (data.size() - at < 4) throw std::runtime_error("Corrupt compressed presentation: truncated");
+        std::uint32_t rawSize = getU32(data.data() + at);
+        if (rawSize == 0) {
+            at += 4;
+            break;
+        }
+        if (data.size() - at < blockHeaderSize) throw std::runtime_error("Corrupt compressed presentation: truncated");
+        std::uint32_t storedField = getU32(data.data() + at + 4);
+        std::size_t storedSize = storedField & ~storedRaw;
+        bool compressed = (storedField & storedRaw) == 0;
+        at += blockHeaderSize;
+        // Checked before anything is allocated, so a few header bytes
+        // cannot claim gigabytes of output.
+        if (rawSize > maxBlock || storedSize > data.size() - at || (!compressed && storedSize != rawSize) ||
+            (compressed && rawSize > LzCodec::maxDecompressed(storedSize))) {
+            throw std::runtime_error("Corrupt compressed presentation: bad block size");
+        }
+        blocks.push_back({data.data() + at, storedSize, rawSize, total, compressed});
+        total += rawSize;
+        at += storedSize;
+    }
+    if (at != data.size()) throw std::runtime_error("Corrupt compressed presentation: trailing data");
+
+    std::unique_ptr<char[]> raw(new char[total]);
+    std::vector<char> valid(blocks.size(), 1);
+    runParallel(blocks.size(), threadCount(), [&](std::size_t i) {
+        const Block& block = blocks[i];
+        if (block.compressed) {
+            valid[i] = LzCodec::decompress(block.stored, block.storedSize, raw.get() + block.offset, block.rawSize);
+        } else {
+            std::memcpy(raw.get() + block.offset, block.stored, block.rawSize);
+        }
+    });
+    if (std::find(valid.begin(), valid.end(), 0) != valid.end()) {
+        throw std::runtime_error("Corrupt compressed presentation: bad block");
+    }
+
+    inner_->read(repo, factory, std::string_view(raw.get(), total));
+}
+
+void CompressedSerializer::save(const ISlideView& view, const std::string& filepath) const {
+    try {
+        AtomicFile file(filepath);
+        if (!file.isOpen()) {
+            std::cout << "Error: Cannot open file " << filepath << std::endl;
+            return;
+        }
+
+        write(view, file.stream());
+        if (!file.commit()) {
+            std::cout << "Error saving to " << filepath << ": write failed" << std::endl;
+            return;
+        }
+        std::cout << "Saved presentation to " << filepath << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "Error saving to " << filepath << ": " << e.what() << std::endl;
+    }
+}
+
+bool CompressedSerializer::load(ISlideRepository& repo, SlideFactory& factory, const std::string& filepath) {
+    try {
+        MappedFile file(filepath);
+        read(repo, factory, file.view());
+    } catch (const std::exception& e) {
+        std::cout << "Error loading " << filepath << ": " << e.what() << std::endl;
+        return false;
+    }
+    std::cout << "Loaded presentation from " << filepath << std::endl;
+    return true;
+}
@@ -1,45 +1,658 @@
 #include "../../include/serialization/JsonSerializer.hpp"
+#include "../../include/serialization/AsyncSaver.hpp"
+#include "../../include/serialization/AtomicFile.hpp"
+#include "../../include/serialization/JsonWriter.hpp"
+#include "../../include/serialization/LazyJsonSource.hpp"
+#include "../../include/serialization/MappedFile.hpp"
+#include "../../include/serialization/SerializerFactory.hpp"
+#include "../../include/serialization/SlideSaxHandler.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <sstream>
+#include <thread>
 
-void JsonSerializer::save(const ISlideRepository& repo, const std::string& filepath) const {
+#if !defined(_WIN32)
+#include <cerrno>
+#include <climits>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Output file that takes a batch of buffers per write: one writev() call on
+// POSIX systems, plain sequential writes elsewhere.
+class VectoredFile {
+public:
+    explicit VectoredFile(const std::string& path) {
+#if defined(_WIN32)
+        out_.open(path, std::ios::binary);
+#else
+        fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+    }
+
+    ~VectoredFile() { close(); }
+
+    bool isOpen() const {
+#if defined(_WIN32)
+        return out_.is_open();
+#else
+        return fd_ >= 0;
+#endif
+    }
+
+    bool write(const std::vector<std::string>& pieces) {
+#if defined(_WIN32)
+        for (const auto& piece : pieces) {
+            out_.write(piece.data(), static_cast<std::streamsize>(piece.size()));
+        }
+        return static_cast<bool>(out_);
+#else
+        std::vector<iovec> vectors;
+        vectors.reserve(pieces.size());
+        for (const auto& piece : pieces) {
+            if (!piece.empty()) {
+                vectors.push_back(iovec{const_cast<char*>(piece.data()), piece.size()});
+            }
+        }
+
+        // writev() may stop short; resume from the first unwritten byte.
+        std::size_t next = 0;
+        while (next < vectors.size()) {
+            int batch = static_cast<int>(std::min<std::size_t>(vectors.size() - next, IOV_MAX));
+            ssize_t written = ::writev(fd_, vectors.data() + next, batch);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+
+            auto left = static_cast<std::size_t>(written);
+            while (next < vectors.size() && left >= vectors[next].iov_len) {
+                left -= vectors[next++].iov_len;
+            }
+            if (left > 0) {
+                vectors[next].iov_base = static_cast<char*>(vectors[next].iov_base) + left;
+                vectors[next].iov_len -= left;
+            }
+        }
+        return true;
+#endif
+    }
+
+    bool close() {
+#if defined(_WIN32)
+        if (!out_.is_open()) return true;
+        out_.close();
+        return static_cast<bool>(out_);
+#else
+        if (fd_ < 0) return true;
+        int result = ::close(fd_);
+        fd_ = -1;
+        return result == 0;
+#endif
+    }
+
+private:
+#if defined(_WIN32)
+    std::ofstream out_;
+#else
+    int fd_ = -1;
+#endif
+};
+
+// First line of a journal for `filepath`: its size and an FNV-1a hash of its
+// bytes, so a journal left beside a newer file is not applied to it. Empty
+// if the file cannot be read.
+std::string journalHeader(const std::string& filepath) {
     try {
-        nlohmann::json presentation = repo.toJson();
-        std::ofstream file(filepath);
-        if (!file.is_open()) {
-            std::cout << "Error: Cannot open file " << filepath << std::endl;
-            return;
+        MappedFile file(filepath);
+        std::uint64_t hash = 14695981039346656037ull;
+        for (char c : file.view()) {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
         }
+        char hex[17];
+        std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+        return "{\"base\":" + std::to_string(file.size()) + ",\"hash\":\"" + hex + "\"}\n";
+    } catch (const std::exception&) {
+        return std::string();
+    }
+}
 
-        file << presentation.dump(4);
-        file.close();
+}
+
+JsonSerializer::JsonSerializer() = default;
+
+JsonSerializer::~JsonSerializer() = default;
+
+void JsonSerializer::save(const ISlideView& view, const std::string& filepath) const {
+    save(view, filepath, false);
+}
+
+void JsonSerializer::save(const ISlideView& view, const std::string& filepath, bool compact) const {
+    if (filepath == journalTarget_) {
+        journalTarget_.clear();
+    }
+    if (writeFile(view, filepath, compact)) {
         std::cout << "Saved presentation to " << filepath << std::endl;
+    }
+}
+
+// A journal starts with a line naming the file it extends,
+//   {"base":<size>,"hash":"<FNV-1a of the file>"}
+// and each entry after it is one compact line:
+//   {"ops":[["insert",index,id],["remove",id],["move",from,to],["clear"]],
+//    "slides":[<changed slide>,...]}
+// The ops restore the order, then each listed slide replaces the slide with
+// its ID. Writing an entry costs O(changes) however large the deck is.
+void JsonSerializer::saveJournal(ISlideRepository& repo, const std::string& filepath) {
+    if (filepath != journalTarget_) {
+        if (writeFile(repo, filepath, false)) {
+            trackJournal(repo, filepath);
+            std::cout << "Saved presentation to " << filepath << std::endl;
+        }
+        return;
+    }
+
+    const ISlideRepository& view = repo;
+    const ChangeLog& changes = repo.changes();
+    std::ostringstream entry;
+    std::size_t written = 0;
+    try {
+        JsonWriter writer(entry, -1);
+        writer.beginObject();
+        writer.key("ops");
+        writer.beginArray();
+        for (const auto& op : changes.ops) {
+            writer.beginArray();
+            switch (op.type) {
+                case ChangeLog::OpType::Insert:
+                    writer.value("insert");
+                    writer.value(static_cast<int>(op.from));
+                    writer.value(op.id);
+                    break;
+                case ChangeLog::OpType::Remove:
+                    writer.value("remove");
+                    writer.value(op.id);
+                    break;
+                case ChangeLog::OpType::Move:
+                    writer.value("move");
+                    writer.value(static_cast<int>(op.from));
+                    writer.value(static_cast<int>(op.to));
+                    break;
+                case ChangeLog::OpType::Clear:
+                    writer.value("clear");
+                    break;
+            }
+            writer.endArray();
+        }
+        writer.endArray();
+        writer.key("slides");
+        writer.beginArray();
+        for (const auto& [id, revision] : changes.touched) {
+            std::size_t index = view.indexOf(id);
+            const Slide* slide = index == ISlideRepository::npos ? nullptr : view.getSlideAt(index);
+            if (slide && (revision == ChangeLog::inserted || slide->revision() != revision)) {
+                slide->writeJson(writer);
+                ++written;
+            }
+        }
+        writer.endArray();
+        writer.endObject();
+        writer.flush();
+    } catch (const std::exception& e) {
+        std::cout << "Error saving to " << filepath << ": " << e.what() << std::endl;
+        return;
+    }
+
+    if (changes.ops.empty() && written == 0) {
+        std::cout << "Saved presentation to " << filepath << " (no changes)" << std::endl;
+        return;
+    }
+
+    std::string line = entry.str();
+    line += '\n';
+    if (journalSize_ + line.size() > baseSize_ / 2) {
+        if (writeFile(repo, filepath, false)) {
+            trackJournal(repo, filepath);
+            std::cout << "Saved presentation to " << filepath << " (journal compacted)" << std::endl;
+        }
+        return;
+    }
+
+    // The first entry after a full save starts a new journal.
+    if (journalSize_ == 0) {
+        line.insert(0, journalHeader(filepath));
+    }
+    std::ofstream journal(filepath + ".journal",
+                          (journalSize_ == 0 ? std::ios::trunc : std::ios::app) | std::ios::binary);
+    if (!journal.write(line.data(), static_cast<std::streamsize>(line.size())) || !journal.flush()) {
+        std::cout << "Error saving to " << filepath << ": cannot append to journal" << std::endl;
+        return;
+    }
+    journalSize_ += line.size();
+    repo.markSaved();
+    std::cout << "Saved " << written << " changed slide(s) to " << filepath << ".journal" << std::endl;
+}
+
+// Streams the presentation straight from the model. The indented output is
+// byte-for-byte what view.toJson().dump(4) produces; compact matches dump().
+// Lazily loaded slides that were never touched are copied from their source
+// file as is. The file is written beside the target and renamed over it, so
+// a source that is still mapped is never truncated under the repository.
+// Any journal for the target is removed first: it describes changes on top
+// of the old file, which the new one already contains.
+bool JsonSerializer::writeFile(const ISlideView& view, const std::string& filepath, bool compact) const {
+    try {
+        AtomicFile file(filepath);
+        if (!file.isOpen()) {
+            std::cout << "Error: Cannot open file " << filepath << std::endl;
+            return false;
+        }
+
+        JsonWriter writer(file.stream(), compact ? -1 : 4);
+        view.writeJson(writer);
+        writer.flush();
+
+        if (!file.commit(filepath + ".journal")) {
+            std::cout << "Error saving to " << filepath << ": write failed" << std::endl;
+            return false;
+        }
+        return true;
+    } catch (const std::exception& e) {
+        std::cout << "Error saving to " << filepath << ": " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Only taking the snapshot happens here. The background thread must not
+// build lazy slides, as that allocates from the repository's memory
+// resource: JSON copies them through unbuilt from an isolated snapshot, and
+// the other formats, which need every slide built, get them built here.
+void JsonSerializer::saveAsync(const ISlideRepository& repo, const std::string& filepath, bool compact) {
+    if (filepath == journalTarget_) {
+        journalTarget_.clear();
+    }
+    if (!saver_) {
+        saver_ = std::make_unique<AsyncSaver>();
+    }
+
+    if (std::shared_ptr<ISerializer> format = SerializerFactory::forFile(filepath)) {
+        repo.forEachSlide([](const Slide&, std::size_t) {});
+        SlideSnapshot snapshot = repo.snapshot();
+        saver_->submit(filepath, [format, snapshot](std::ostream& out) { format->write(snapshot, out); });
+        return;
+    }
+
+    SlideSnapshot snapshot = repo.snapshot().isolated();
+    int indent = compact ? -1 : 4;
+    saver_->submit(filepath, [snapshot, indent](std::ostream& out) {
+        JsonWriter writer(out, indent);
+        snapshot.writeJson(writer);
+        writer.flush();
+    }, filepath + ".journal");
+}
+
+void JsonSerializer::reportSaves() {
+    if (!saver_) {
+        return;
+    }
+    for (const auto& report : saver_->takeReports()) {
+        std::cout << report << std::endl;
+    }
+}
+
+void JsonSerializer::waitForSaves() {
+    if (!saver_) {
+        return;
+    }
+    saver_->wait();
+    reportSaves();
+}
+
+// Slides are serialized in rounds. In each round every worker renders one
+// contiguous range of slides into its own buffer, then the round's buffers
+// are written in order with a single vectored write. Memory stays bounded
+// by one round of output rather than the whole file, and the bytes are
+// exactly those writeFile() produces.
+void JsonSerializer::saveParallel(const ISlideRepository& repo, const std::string& filepath, bool compact,
+                                  unsigned workers) const {
+    constexpr std::size_t slidesPerRange = 2048;
+
+    unsigned threadLimit = workers != 0 ? workers : std::thread::hardware_concurrency();
+    if (threadLimit <= 1) {
+        save(repo, filepath, compact);
+        return;
+    }
+    if (filepath == journalTarget_) {
+        journalTarget_.clear();
+    }
+
+    std::string tempPath = filepath + ".tmp";
+    VectoredFile file(tempPath);
+    if (!file.isOpen()) {
+        std::cout << "Error: Cannot open file " << filepath << std::endl;
+        return;
+    }
+
+    try {
+        SlideSnapshot snapshot = repo.snapshot();
+        std::size_t count = snapshot.slideCount();
+        int indent = compact ? -1 : 4;
+        std::vector<std::string> pieces;
+        std::vector<std::string> errors(threadLimit);
+        bool written = true;
+
+        JsonWriter head(indent);
+        SlideSnapshot::writeJsonHead(head);
+        pieces.push_back(head.take());
+        for (std::size_t begin = 0; begin < count && written; begin += threadLimit * slidesPerRange) {
+            std::size_t ranges = std::min<std::size_t>(threadLimit, (count - begin + slidesPerRange - 1) / slidesPerRange);
+            std::size_t first = pieces.size();
+            pieces.resize(first + ranges);
+            auto render = [&](std::size_t range) {
+                try {
+                    std::size_t from = begin + range * slidesPerRange;
+                    JsonWriter writer(indent);
+                    snapshot.writeJsonSlides(writer, from, std::min(count, from + slidesPerRange));
+                    pieces[first + range] = writer.take();
+                } catch (const std::exception& e) {
+                    errors[range] = e.what();
+                }
+            };
+
+            std::vector<std::thread> threads;
+            std::size_t started = 1;
+            try {
+                for (; started < ranges; ++started) {
+                    threads.emplace_back(render, started);
+                }
+            } catch (const std::system_error&) {
+                // Ranges without a thread are rendered here below.
+            }
+            render(0);
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            for (std::size_t range = started; range < ranges; ++range) {
+                render(range);
+            }
+            for (const auto& error : errors) {
+                if (!error.empty()) throw std::runtime_error(error);
+            }
+
+            written = file.write(pieces);
+            pieces.clear();
+        }
+
+        JsonWriter tail(indent);
+        SlideSnapshot::writeJsonTail(tail, count);
+        pieces.push_back(tail.take());
+        if (!written || !file.write(pieces) || !file.close()) {
+            throw std::runtime_error("write failed");
+        }
+        if (AtomicFile::replace(tempPath, filepath, filepath + ".journal")) {
+            std::cout << "Saved presentation to " << filepath << std::endl;
+        } else {
+            std::cout << "Error saving to " << filepath << ": write failed" << std::endl;
+        }
     } catch (const std::exception& e) {
+        file.close();
+        std::remove(tempPath.c_str());
         std::cout << "Error saving to " << filepath << ": " << e.what() << std::endl;
     }
 }
 
-void JsonSerializer::load(ISlideRepository& repo, SlideFactory& factory, const std::string& filepath) {
+// Starts a new change log relative to `filepath`, which a journal save has
+// just written in full. Any journal beside it is stale and is replaced by
+// the next entry.
+void JsonSerializer::trackJournal(ISlideRepository& repo, const std::string& filepath) {
+    std::error_code error;
+    baseSize_ = std::filesystem::file_size(filepath, error);
+    journalSize_ = 0;
+    journalTarget_ = filepath;
+    repo.markSaved();
+}
+
+// Loading changes the deck behind any journal, and edits are only logged
+// once a journal save asks for them, so the next journal save is a full one.
+void JsonSerializer::stopJournal(ISlideRepository& repo) {
+    journalTarget_.clear();
+    repo.stopChangeLog();
+}
+
+// Applies `<filepath>.journal`, if there is one, to the slides just loaded
+// from `filepath`, which start at position `base`. A journal written for
+// another version of the file is ignored, as are a damaged entry (say, a
+// save cut short) and everything after it. Returns the next free slide ID.
+int JsonSerializer::replayJournal(ISlideRepository& repo, const std::string& filepath, std::size_t base, int maxId) const {
+    std::ifstream journal(filepath + ".journal");
+    std::string line;
+    if (!std::getline(journal, line)) {
+        return maxId;
+    }
+    if (line + '\n' != journalHeader(filepath)) {
+        std::cout << "Ignoring " << filepath << ".journal: it belongs to another version of the file" << std::endl;
+        return maxId;
+    }
+
+    while (std::getline(journal, line)) {
+        try {
+            nlohmann::json entry = nlohmann::json::parse(line);
+            for (const auto& op : entry.at("ops")) {
+                const std::string& type = op.at(0).get_ref<const std::string&>();
+                if (type == "insert") {
+                    int id = op.at(2);
+                    maxId = std::max(maxId, id + 1);
+                    Slide::allocator_type alloc(repo.slideResource());
+                    repo.insertSlide(base + op.at(1).get<std::size_t>(), std::make_unique<Slide>(id, "", "", "", alloc));
+                } 
+                else if (type == "remove") {
+                    repo.removeSlideById(op.at(1));
+                } 
+                else if (type == "move") {
+                    repo.moveSlide(base + op.at(1).get<std::size_t>(), base + op.at(2).get<std::size_t>());
+                } 
+                else if (type == "clear") {
+                    while (repo.slideCount() > base) {
+                        repo.removeSlideById(static_cast<const ISlideRepository&>(repo).getSlideAt(base)->getId());
+                    }
+                }
+            }
+
+            for (const auto& slideJson : entry.at("slides")) {
+                std::size_t index = repo.indexOf(slideJson.at("id"));
+                if (index == ISlideRepository::npos) {
+                    continue;
+                }
+                repo.removeSlideById(slideJson["id"]);
+                repo.insertSlide(index, SlideFactory::fromJson(slideJson, maxId, repo.slideResource()));
+            }
+        } catch (const std::exception& e) {
+            std::cout << "Ignoring damaged journal entry in " << filepath << ".journal: " << e.what() << std::endl;
+            break;
+        }
+    }
+
+    return maxId;
+}
+
+bool JsonSerializer::load(ISlideRepository& repo, SlideFactory& factory, const std::string& filepath, bool lazy) {
+    if (!lazy) {
+        return load(repo, factory, filepath);
+    }
+
+    std::shared_ptr<LazyJsonSource> source;
+    try {
+        source = std::make_shared<LazyJsonSource>(filepath);
+        source->validate();
+    } catch (const std::exception& e) {
+        std::cout << "Error loading " << filepath << ": " << e.what() << std::endl;
+        return false;
+    }
+
+    if (!source->foundSlides()) {
+        std::cout << "Invalid JSON format in " << filepath << std::endl;
+        return false;
+    }
+
+    std::size_t base = repo.slideCount();
+    repo.addLazySlides(source);
+    factory.resetId(replayJournal(repo, filepath, base, source->maxId()));
+    stopJournal(repo);
+    std::cout << "Loaded presentation from " << filepath << std::endl;
+    return true;
+}
+
+// The lazy loader's structural pass finds every slide's byte range; the
+// slides are then split into one contiguous run per worker, and each worker
+// parses its run into its own arena. Once all workers are done the slides
+// are added in file order and the arenas handed to the repository, so
+// nothing is copied. Any malformed slide leaves the repository untouched.
+bool JsonSerializer::loadParallel(ISlideRepository& repo, SlideFactory& factory, const std::string& filepath,
+                                  unsigned workers) {
+    // Fewer slides than this per worker are not worth a thread.
+    constexpr std::size_t minSlidesPerWorker = 256;
+
+    struct Batch {
+        std::shared_ptr<std::pmr::memory_resource> arena = std::make_shared<std::pmr::synchronized_pool_resource>();
+        std::vector<std::unique_ptr<Slide>> slides;
+        int maxId = 1;
+        std::string error;
+    };
+
+    unsigned threadLimit = workers != 0 ? workers : std::thread::hardware_concurrency();
+    if (threadLimit <= 1) {
+        // The index pass only pays off when there is a second core to use.
+        return load(repo, factory, filepath);
+    }
+
+    std::unique_ptr<LazyJsonSource> index;
+    try {
+        index = std::make_unique<LazyJsonSource>(filepath);
+    } catch (const std::exception& e) {
+        std::cout << "Error loading " << filepath << ": " << e.what() << std::endl;
+        return false;
+    }
+
+    if (!index->foundSlides()) {
+        std::cout << "Invalid JSON format in " << filepath << std::endl;
+        return false;
+    }
+
+    std::size_t count = index->size();
+    std::size_t threadCount = std::clamp<std::size_t>(count / minSlidesPerWorker, 1, threadLimit);
+    std::vector<Batch> batches(threadCount);
+    auto parse = [&](std::size_t worker) {
+        Batch& batch = batches[worker];
+        try {
+            SlideSaxHandler handler(batch.arena.get(), true);
+            std::size_t end = count * (worker + 1) / threadCount;
+            for (std::size_t entry = count * worker / threadCount; entry < end; ++entry) {
+                std::string_view json = index->jsonAt(entry);
+                nlohmann::json::sax_parse(json.begin(), json.end(), &handler);
+            }
+            batch.slides = handler.takeSlides();
+            batch.maxId = handler.maxId();
+        } catch (const std::exception& e) {
+            batch.error = e.what();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    try {
+        for (std::size_t worker = 1; worker < threadCount; ++worker) {
+            threads.emplace_back(parse, worker);
+        }
+    } catch (const std::system_error&) {
+        // Could not start every thread: the ones that did run, and the rest of
+        // the batches are parsed here afterwards.
+    }
+    parse(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (std::size_t worker = threads.size() + 1; worker < threadCount; ++worker) {
+        parse(worker);
+    }
+
+    for (const auto& batch : batches) {
+        if (!batch.error.empty()) {
+            std::cout << "Error loading " << filepath << ": " << batch.error << std::endl;
+            return false;
+        }
+    }
+
+    std::size_t base = repo.slideCount();
+    int maxId = 1;
+    for (auto& batch : batches) {
+        repo.adoptResource(batch.arena);
+        for (auto& slide : batch.slides) {
+            repo.addSlide(std::move(slide));
+        }
+        maxId = std::max(maxId, batch.maxId);
+    }
+
+    factory.resetId(replayJournal(repo, filepath, base, maxId));
+    stopJournal(repo);
+    std::cout << "Loaded presentation from " << filepath << std::endl;
+    return true;
+}
+
+void JsonSerializer::write(const ISlideView& view, std::ostream& out) const {
+    JsonWriter writer(out);
+    view.writeJson(writer);
+    writer.flush();
+}
+
+void JsonSerializer::read(ISlideRepository& repo, SlideFactory& factory, std::string_view data) {
+    SlideSaxHandler handler(repo.slideResource());
+    nlohmann::json::sax_parse(data.begin(), data.end(), &handler);
+    if (!handler.foundSlides()) {
+        throw std::runtime_error("Invalid JSON format");
+    }
+
+    for (auto& slide : handler.takeSlides()) {
+        repo.addSlide(std::move(slide));
+    }
+    factory.resetId(handler.maxId());
+}
+
+bool JsonSerializer::load(ISlideRepository& repo, SlideFactory& factory, const std::string& filepath) {
     std::ifstream file(filepath);
     if (!file.is_open()) {
         std::cout << "Failed to open file: " << filepath << std::endl;
-        return;
+        return false;
     }
 
-    nlohmann::json j;
-    file >> j;
+    // Slides are only added once the whole file has parsed, so a malformed
+    // file leaves the repository untouched.
+    SlideSaxHandler handler(repo.slideResource());
+    try {
+        nlohmann::json::sax_parse(file, &handler);
+    } catch (const std::exception& e) {
+        std::cout << "Error loading " << filepath << ": " << e.what() << std::endl;
+        return false;
+    }
     file.close();
 
-    int maxId = 1;
-    if (j.contains("slides") && j["slides"].is_array()) {
-        for (const auto& slideJson : j["slides"]) {
-            repo.addSlide(factory.fromJson(slideJson, maxId));
+    if (handler.foundSlides()) {
+        std::size_t base = repo.slideCount();
+        for (auto& slide : handler.takeSlides()) {
+            repo.addSlide(std::move(slide));
         }
     
-        factory.resetId(maxId);
+        factory.resetId(replayJournal(repo, filepath, base, handler.maxId()));
+        stopJournal(repo);
         std::cout << "Loaded presentation from " << filepath << std::endl;
+        return true;
     } 
     else {
         std::cout << "Invalid JSON format in " << filepath << std::endl;
+        return false;
     }
 }
\ No newline at end of file
@@ -0,0 +1,152 @@
+#include "../../include/serialization/JsonWriter.hpp"
+#include <nlohmann/json.hpp>
+#include <charconv>
+#include <cmath>
+
+JsonWriter::JsonWriter(std::ostream& out, int indent) : out_(&out), indent_(indent) {
+    buffer_.reserve(bufferSize);
+}
+
+JsonWriter::JsonWriter(int indent) : out_(nullptr), indent_(indent) {}
+
+JsonWriter::~JsonWriter() { flush(); }
+
+void JsonWriter::resume(std::size_t depth, std::size_t elements) {
+    counts_.assign(depth, 1);
+    if (depth > 0) counts_.back() = elements;
+    afterKey_ = false;
+}
+
+std::string JsonWriter::take() {
+    std::string result = std::move(buffer_);
+    buffer_.clear();
+    return result;
+}
+
+void JsonWriter::beginObject() {
+    beginValue();
+    put('{');
+    counts_.push_back(0);
+}
+
+void JsonWriter::endObject() {
+    std::size_t count = counts_.back();
+    counts_.pop_back();
+    if (count > 0) newline();
+    put('}');
+}
+
+void JsonWriter::beginArray() {
+    beginValue();
+    put('[');
+    counts_.push_back(0);
+}
+
+void JsonWriter::endArray() {
+    std::size_t count = counts_.back();
+    counts_.pop_back();
+    if (count > 0) newline();
+    put(']');
+}
+
+void JsonWriter::key(std::string_view name) {
+    beginValue();
+    put('"');
+    escape(name);
+    put(indent_ >= 0 ? "\": " : "\":");
+    afterKey_ = true;
+}
+
+void JsonWriter::value(std::string_view str) {
+    beginValue();
+    put('"');
+    escape(str);
+    put('"');
+}
+
+void JsonWriter::value(const char* str) { value(std::string_view(str)); }
+
+void JsonWriter::value(int number) {
+    beginValue();
+    char digits[16];
+    auto result = std::to_chars(digits, digits + sizeof(digits), number);
+    put(std::string_view(digits, static_cast<std::size_t>(result.ptr - digits)));
+}
+
+// Same shortest round-trip formatting nlohmann::json uses for floats.
+void JsonWriter::value(double number) {
+    beginValue();
+    if (!std::isfinite(number)) {
+        put("null");
+        return;
+    }
+
+    char digits[64];
+    char* end = nlohmann::detail::to_chars(digits, digits + sizeof(digits), number);
+    put(std::string_view(digits, static_cast<std::size_t>(end - digits)));
+}
+
+// Emits an already serialized value as is.
+void JsonWriter::raw(std::string_view json) {
+    beginValue();
+    put(json);
+}
+
+void JsonWriter::flush() {
+    if (!out_) return;
+    out_->write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+}
+
+// Emits the separator and indentation that precede a new element. A value
+// that directly follows its key needs neither.
+void JsonWriter::beginValue() {
+    if (afterKey_) {
+        afterKey_ = false;
+        return;
+    }
+    if (counts_.empty()) return;
+
+    if (counts_.back()++ > 0) put(',');
+    newline();
+}
+
+void JsonWriter::newline() {
+    if (indent_ < 0) return;
+
+    put('\n');
+    buffer_.append(counts_.size() * static_cast<std::size_t>(indent_), ' ');
+}
+
+void JsonWriter::escape(std::string_view str) {
+    static const char hex[] = "0123456789abcdef";
+    for (char c : str) {
+        switch (c) {
+            case '"': put("\\\""); break;
+            case '\\': put("\\\\"); break;
+            case '\b': put("\\b"); break;
+            case '\f': put("\\f"); break;
+            case '\n': put("\\n"); break;
+            case '\r': put("\\r"); break;
+            case '\t': put("\\t"); break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    put("\\u00");
+                    put(hex[(c >> 4) & 0xF]);
+                    put(hex[c & 0xF]);
+                } else {
+                    put(c);
+                }
+        }
+    }
+}
+
+void JsonWriter::put(char c) {
+    buffer_.push_back(c);
+    if (out_ && buffer_.size() >= bufferSize) flush();
+}
+
+void JsonWriter::put(std::string_view str) {
+    buffer_.append(str);
+    if (out_ && buffer_.size() >= bufferSize) flush();
+}
@@ -0,0 +1,208 @@
+#include "../../include/serialization/LazyJsonSource.hpp"
+#include "../../include/serialization/SlideSaxHandler.hpp"
+#include "../../include/core/SlideFactory.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+// Minimal structural scanner: it matches brackets and skips strings so it
+// can find value boundaries. Values outside "slides" are syntax-checked as
+// they are skipped; slide contents are left to LazyJsonSource::validate().
+class Scanner {
+public:
+    explicit Scanner(std::string_view text) : text_(text) {}
+
+    std::size_t position() const { return pos_; }
+
+    char peek() {
+        skipWhitespace();
+        if (pos_ >= text_.size()) fail("unexpected end of input");
+        return text_[pos_];
+    }
+
+    void expect(char c) {
+        if (peek() != c) fail(std::string("expected '") + c + "'");
+        ++pos_;
+    }
+
+    bool consume(char c) {
+        if (peek() != c) return false;
+        ++pos_;
+        return true;
+    }
+
+    // Returns the raw (still escaped) contents of the string at the cursor.
+    std::string_view string() {
+        expect('"');
+        std::size_t begin = pos_;
+        pos_ = closingQuote(pos_);
+        return text_.substr(begin, pos_++ - begin);
+    }
+
+    int integer() {
+        skipWhitespace();
+        int value = 0;
+        auto result = std::from_chars(text_.data() + pos_, text_.data() + text_.size(), value);
+        if (result.ec != std::errc()) fail("expected an integer slide id");
+        pos_ = static_cast<std::size_t>(result.ptr - text_.data());
+        skipValue();
+        return value;
+    }
+
+    void skipValue() {
+        char c = peek();
+        if (c == '"') {
+            string();
+            return;
+        }
+        if (c != '{' && c != '[') {
+            // Scalar, or the remainder of one (such as the ".0" of "3.0").
+            while (pos_ < text_.size() && std::string_view(",]} \t\r\n").find(text_[pos_]) == std::string_view::npos) {
+                ++pos_;
+            }
+            return;
+        }
+
+        // Strings are skipped with memchr and everything else is only looked
+        // at for brackets. The parallel loader runs this pass on one thread
+        // before splitting the work, so it avoids the per-character checks
+        // of peek().
+        std::size_t depth = 0;
+        for (; pos_ < text_.size(); ++pos_) {
+            c = text_[pos_];
+            if (c == '"') {
+                pos_ = closingQuote(pos_ + 1);
+            } else if (c == '{' || c == '[') {
+                ++depth;
+            } else if ((c == '}' || c == ']') && --depth == 0) {
+                ++pos_;
+                return;
+            }
+        }
+        fail("unexpected end of input");
+    }
+
+    // Fails unless the text from `begin` to the cursor is a JSON value.
+    void checkSince(std::size_t begin) {
+        std::string_view value = text_.substr(begin, pos_ - begin);
+        if (!nlohmann::json::accept(value.begin(), value.end())) fail("malformed value");
+    }
+
+    void expectEnd() {
+        skipWhitespace();
+        if (pos_ != text_.size()) fail("unexpected data after the presentation");
+    }
+
+    [[noreturn]] void fail(const std::string& message) const {
+        throw std::runtime_error("Invalid JSON at offset " + std::to_string(pos_) + ": " + message);
+    }
+
+private:
+    void skipWhitespace() {
+        while (pos_ < text_.size() && (text_[pos_] == ' ' || text_[pos_] == '\n' || text_[pos_] == '\t' || text_[pos_] == '\r')) {
+            ++pos_;
+        }
+    }
+
+    // Position of the quote that ends the string whose contents start at
+    // `from`: the first quote not preceded by an odd run of backslashes.
+    std::size_t closingQuote(std::size_t from) const {
+        const char* begin = text_.data();
+        const char* end = begin + text_.size();
+        const char* p = begin + from;
+        while (const void* found = std::memchr(p, '"', static_cast<std::size_t>(end - p))) {
+            const char* quote = static_cast<const char*>(found);
+            const char* run = quote;
+            while (run > begin + from && run[-1] == '\\') --run;
+            if ((quote - run) % 2 == 0) return static_cast<std::size_t>(quote - begin);
+            p = quote + 1;
+        }
+        fail("unterminated string");
+    }
+
+    std::string_view text_;
+    std::size_t pos_ = 0;
+};
+
+}
+
+LazyJsonSource::LazyJsonSource(const std::string& filepath) : file_(filepath) {
+    Scanner in(file_.view());
+    in.expect('{');
+    if (in.consume('}')) return;
+
+    do {
+        in.peek();
+        std::size_t keyBegin = in.position();
+        std::string_view key = in.string();
+        in.checkSince(keyBegin);
+        in.expect(':');
+        if (key != "slides" || in.peek() != '[') {
+            std::size_t valueBegin = in.position();
+            in.skipValue();
+            in.checkSince(valueBegin);
+            continue;
+        }
+
+        foundSlides_ = true;
+        entries_.clear();
+        in.expect('[');
+        if (in.consume(']')) continue;
+
+        do {
+            in.peek();
+            std::size_t begin = in.position();
+            bool hasId = false;
+            int id = 0;
+            in.expect('{');
+            if (!in.consume('}')) {
+                do {
+                    std::string_view field = in.string();
+                    in.expect(':');
+                    if (field == "id") {
+                        id = in.integer();
+                        hasId = true;
+                    } else {
+                        in.skipValue();
+                    }
+                } while (in.consume(','));
+                in.expect('}');
+            }
+            if (!hasId) in.fail("slide without an id");
+
+            entries_.push_back(Entry{begin, in.position() - begin, id});
+            maxId_ = std::max(maxId_, id + 1);
+        } while (in.consume(','));
+        in.expect(']');
+    } while (in.consume(','));
+    in.expect('}');
+    in.expectEnd();
+}
+
+bool LazyJsonSource::foundSlides() const { return foundSlides_; }
+int LazyJsonSource::maxId() const { return maxId_; }
+// Runs each slide through the checks a full load applies, so a file the
+// eager loader rejects is rejected here instead of on first access.
+void LazyJsonSource::validate() const {
+    SlideSaxHandler handler(std::pmr::get_default_resource(), true, true);
+    for (std::size_t entry = 0; entry < entries_.size(); ++entry) {
+        std::string_view json = jsonAt(entry);
+        nlohmann::json::sax_parse(json.begin(), json.end(), &handler);
+    }
+}
+
+std::size_t LazyJsonSource::size() const { return entries_.size(); }
+int LazyJsonSource::idAt(std::size_t entry) const { return entries_[entry].id; }
+
+std::string_view LazyJsonSource::jsonAt(std::size_t entry) const {
+    return file_.view().substr(entries_[entry].offset, entries_[entry].length);
+}
+
+std::unique_ptr<Slide> LazyJsonSource::materialize(std::size_t entry, std::pmr::memory_resource* resource) const {
+    std::string_view json = jsonAt(entry);
+    int maxId = 1;
+    return SlideFactory::fromJson(nlohmann::json::parse(json.begin(), json.end()), maxId, resource);
+}
@@ -0,0 +1,137 @@
+#include "../../include/serialization/LzCodec.hpp"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t minMatch = 4;
+constexpr std::size_t maxOffset = 0xFFFF;
+constexpr int hashBits = 14;
+// The format's end conditions, as in LZ4: the last 5 bytes are always
+// literals, and no match starts within the last 12 bytes.
+constexpr std::size_t lastLiterals = 5;
+constexpr std::size_t matchLimit = 12;
+
+std::uint32_t read32(const char* p) {
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+std::uint32_t hash(std::uint32_t v) {
+    return (v * 2654435761u) >> (32 - hashBits);
+}
+
+char* putLength(char* out, std::size_t length) {
+    for (; length >= 255; length -= 255) *out++ = static_cast<char>(255);
+    *out++ = static_cast<char>(length);
+    return out;
+}
+
+char* putSequence(char* out, const char* literals, std::size_t literalCount, std::size_t matchLength,
+                  std::size_t offset) {
+    char* token = out++;
+    std::uint8_t high = literalCount >= 15 ? 15 : static_cast<std::uint8_t>(literalCount);
+    if (literalCount >= 15) out = putLength(out, literalCount - 15);
+    std::memcpy(out, literals, literalCount);
+    out += literalCount;
+
+    std::uint8_t low = 0;
+    if (matchLength > 0) {
+        *out++ = static_cast<char>(offset & 0xFF);
+        *out++ = static_cast<char>(offset >> 8);
+        std::size_t extra = matchLength - minMatch;
+        low = extra >= 15 ? 15 : static_cast<std::uint8_t>(extra);
+        if (extra >= 15) out = putLength(out, extra - 15);
+    }
+    *token = static_cast<char>((high << 4) | low);
+    return out;
+}
+
+}
+
+std::size_t LzCodec::bound(std::size_t size) {
+    return size + size / 255 + 16;
+}
+
+std::size_t LzCodec::maxDecompressed(std::size_t size) {
+    return size * 255;
+}
+
+// Greedy parse with a single-entry hash table of 4-byte prefixes; fast and
+// good enough on the repetitive key, font and theme strings of a deck.
+std::size_t LzCodec::compress(const char* in, std::size_t size, char* out) {
+    char* const start = out;
+    std::size_t anchor = 0;
+    if (size > matchLimit) {
+        std::vector<std::uint32_t> table(std::size_t{1} << hashBits, 0);
+        std::size_t limit = size - matchLimit;
+        std::size_t pos = 1;
+        while (pos < limit) {
+            std::uint32_t sequence = read32(in + pos);
+            std::uint32_t& slot = table[hash(sequence)];
+            std::size_t candidate = slot;
+            slot = static_cast<std::uint32_t>(pos);
+            if (candidate >= pos || pos - candidate > maxOffset || read32(in + candidate) != sequence) {
+                ++pos;
+                continue;
+            }
+
+            std::size_t length = minMatch;
+            while (pos + length < size - lastLiterals && in[candidate + length] == in[pos + length]) ++length;
+            out = putSequence(out, in + anchor, pos - anchor, length, pos - candidate);
+            pos += length;
+            anchor = pos;
+        }
+    }
+
+    out = putSequence(out, in + anchor, size - anchor, 0, 0);
+    return static_cast<std::size_t>(out - start);
+}
+
+bool LzCodec::decompress(const char* in, std::size_t size, char* out, std::size_t outSize) {
+    std::size_t ip = 0;
+    std::size_t op = 0;
+    auto readLength = [&](std::size_t& length) {
+        std::uint8_t byte;
+        do {
+            if (ip >= size) return false;
+            byte = static_cast<std::uint8_t>(in[ip++]);
+            length += byte;
+        } while (byte == 255);
+        return true;
+    };
+
+    while (ip < size) {
+        std::uint8_t token = static_cast<std::uint8_t>(in[ip++]);
+        std::size_t literals = token >> 4;
+        if (literals == 15 && !readLength(literals)) return false;
+        if (literals > size - ip || literals > outSize - op) return false;
+        std::memcpy(out + op, in + ip, literals);
+        ip += literals;
+        op += literals;
+        if (ip == size) break;
+
+        if (size - ip < 2) return false;
+        std::size_t offset = static_cast<std::uint8_t>(in[ip]) | (static_cast<std::size_t>(static_cast<std::uint8_t>(in[ip + 1])) << 8);
+        ip += 2;
+        std::size_t length = token & 0x0F;
+        if (length == 15 && !readLength(length)) return false;
+        length += minMatch;
+        if (offset == 0 || offset > op || length > outSize - op) return false;
+
+        // Overlapping copies (offset < length) repeat the last `offset`
+        // bytes, so they go forward one byte at a time.
+        char* dst = out + op;
+        const char* src = dst - offset;
+        if (offset >= length) {
+            std::memcpy(dst, src, length);
+        } else {
+            for (std::size_t i = 0; i < length; ++i) dst[i] = src[i];
+        }
+        op += length;
+    }
+
+    return op == outSize;
+}
@@ -0,0 +1,51 @@
+#include "../../include/serialization/MappedFile.hpp"
+#include <stdexcept>
+
+#if defined(_WIN32)
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string& filepath) {
+#if defined(_WIN32)
+    std::ifstream file(filepath, std::ios::binary);
+    if (!file.is_open()) throw std::runtime_error("Failed to open file: " + filepath);
+    buffer_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+#else
+    int fd = ::open(filepath.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Failed to open file: " + filepath);
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot stat file: " + filepath);
+    }
+    size_ = static_cast<std::size_t>(info.st_size);
+    if (size_ > 0) {
+        void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Cannot map file: " + filepath);
+        }
+        data_ = static_cast<const char*>(mapping);
+    }
+    ::close(fd);
+#endif
+}
+
+MappedFile::~MappedFile() {
+#if !defined(_WIN32)
+    if (data_) ::munmap(const_cast<char*>(data_), size_);
+#endif
+}
+
+const char* MappedFile::data() const { return data_; }
+std::size_t MappedFile::size() const { return size_; }
+std::string_view MappedFile::view() const { return std::string_view(data_, size_); }
@@ -0,0 +1,128 @@
+#include "../../include/serialization/PackedJsonSerializer.hpp"
+#include "../../include/serialization/AtomicFile.hpp"
+#include "../../include/serialization/MappedFile.hpp"
+#include "../../include/serialization/SlideSaxHandler.hpp"
+#include <iostream>
+
+namespace {
+
+void putBigEndian(std::vector<std::uint8_t>& out, std::uint64_t value, int bytes) {
+    for (int shift = 8 * (bytes - 1); shift >= 0; shift -= 8) {
+        out.push_back(static_cast<std::uint8_t>(value >> shift));
+    }
+}
+
+void putString(std::vector<std::uint8_t>& out, std::uint8_t lead, std::string_view str) {
+    out.push_back(static_cast<std::uint8_t>(lead | str.size()));
+    out.insert(out.end(), str.begin(), str.end());
+}
+
+}
+
+PackedJsonSerializer::PackedJsonSerializer(Format format) : format_(format) {}
+
+// The envelope is {"language": "C++", "slides": [ with the array length up
+// front, encoded exactly as nlohmann's to_cbor()/to_msgpack() would encode
+// the whole document, so the file is byte-for-byte what they produce.
+void PackedJsonSerializer::writeEnvelope(std::vector<std::uint8_t>& out, std::size_t slideCount) const {
+    if (format_ == Format::Cbor) {
+        out.push_back(0xA2);
+        putString(out, 0x60, "language");
+        putString(out, 0x60, "C++");
+        putString(out, 0x60, "slides");
+        if (slideCount <= 0x17) {
+            out.push_back(static_cast<std::uint8_t>(0x80 + slideCount));
+        } else if (slideCount <= 0xFF) {
+            out.push_back(0x98);
+            putBigEndian(out, slideCount, 1);
+        } else if (slideCount <= 0xFFFF) {
+            out.push_back(0x99);
+            putBigEndian(out, slideCount, 2);
+        } else if (slideCount <= 0xFFFFFFFF) {
+            out.push_back(0x9A);
+            putBigEndian(out, slideCount, 4);
+        } else {
+            out.push_back(0x9B);
+            putBigEndian(out, slideCount, 8);
+        }
+    } else {
+        out.push_back(0x82);
+        putString(out, 0xA0, "language");
+        putString(out, 0xA0, "C++");
+        putString(out, 0xA0, "slides");
+        if (slideCount <= 15) {
+            out.push_back(static_cast<std::uint8_t>(0x90 | slideCount));
+        } else if (slideCount <= 0xFFFF) {
+            out.push_back(0xDC);
+            putBigEndian(out, slideCount, 2);
+        } else {
+            out.push_back(0xDD);
+            putBigEndian(out, slideCount, 4);
+        }
+    }
+}
+
+void PackedJsonSerializer::encode(const nlohmann::json& j, std::vector<std::uint8_t>& out) const {
+    if (format_ == Format::Cbor) {
+        nlohmann::json::to_cbor(j, out);
+    } else {
+        nlohmann::json::to_msgpack(j, out);
+    }
+}
+
+void PackedJsonSerializer::write(const ISlideView& view, std::ostream& out) const {
+    std::vector<std::uint8_t> bytes;
+    writeEnvelope(bytes, view.slideCount());
+    view.forEachSlide([&](const Slide& slide, std::size_t) {
+        encode(slide.toJson(), bytes);
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        bytes.clear();
+    });
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+void PackedJsonSerializer::read(ISlideRepository& repo, SlideFactory& factory, std::string_view data) {
+    SlideSaxHandler handler(repo.slideResource());
+    auto format = format_ == Format::Cbor ? nlohmann::json::input_format_t::cbor
+                                          : nlohmann::json::input_format_t::msgpack;
+    nlohmann::json::sax_parse(data.begin(), data.end(), &handler, format);
+    if (!handler.foundSlides()) {
+        throw std::runtime_error(format_ == Format::Cbor ? "Invalid CBOR format" : "Invalid MessagePack format");
+    }
+
+    for (auto& slide : handler.takeSlides()) {
+        repo.addSlide(std::move(slide));
+    }
+    factory.resetId(handler.maxId());
+}
+
+void PackedJsonSerializer::save(const ISlideView& view, const std::string& filepath) const {
+    try {
+        AtomicFile file(filepath);
+        if (!file.isOpen()) {
+            std::cout << "Error: Cannot open file " << filepath << std::endl;
+            return;
+        }
+
+        write(view, file.stream());
+        if (!file.commit()) {
+            std::cout << "Error saving to " << filepath << ": write failed" << std::endl;
+            return;
+        }
+        std::cout << "Saved presentation to " << filepath << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "Error saving to " << filepath << ": " << e.what() << std::endl;
+    }
+}
+
+bool PackedJsonSerializer::load(ISlideRepository& repo, SlideFactory& factory, const std::string& filepath) {
+    try {
+        MappedFile file(filepath);
+        read(repo, factory, file.view());
+    } catch (const std::exception& e) {
+        std::cout << "Error loading " << filepath << ": " << e.what() << std::endl;
+        return false;
+    }
+    std::cout << "Loaded presentation from " << filepath << std::endl;
+    return true;
+}
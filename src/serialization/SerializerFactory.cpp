@@ -0,0 +1,36 @@
+#include "../../include/serialization/SerializerFactory.hpp"
+#include "../../include/serialization/BinarySerializer.hpp"
+#include "../../include/serialization/CborSerializer.hpp"
+#include "../../include/serialization/CompressedSerializer.hpp"
+#include "../../include/serialization/JsonSerializer.hpp"
+#include "../../include/serialization/MsgPackSerializer.hpp"
+#include <algorithm>
+#include <cctype>
+
+std::unique_ptr<ISerializer> SerializerFactory::forFile(const std::string& filepath) {
+    if (CompressedSerializer::handles(filepath)) {
+        std::string innerPath = filepath.substr(0, filepath.size() - 4);
+        auto inner = forFile(innerPath);
+        if (!inner) inner = std::make_unique<JsonSerializer>();
+        return std::make_unique<CompressedSerializer>(std::move(inner));
+    }
+    if (BinarySerializer::handles(filepath)) {
+        return std::make_unique<BinarySerializer>();
+    }
+    if (CborSerializer::handles(filepath)) {
+        return std::make_unique<CborSerializer>();
+    }
+    if (MsgPackSerializer::handles(filepath)) {
+        return std::make_unique<MsgPackSerializer>();
+    }
+
+    return nullptr;
+}
+
+bool SerializerFactory::hasExtension(std::string_view filepath, std::string_view extension) {
+    if (filepath.size() < extension.size()) return false;
+    std::string_view suffix = filepath.substr(filepath.size() - extension.size());
+    return std::equal(suffix.begin(), suffix.end(), extension.begin(), [](char a, char b) {
+        return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+    });
+}
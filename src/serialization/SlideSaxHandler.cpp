@@ -0,0 +1,240 @@
+#include "../../include/serialization/SlideSaxHandler.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+template <typename... Fields>
+unsigned bits(Fields... fields) { return ((1u << static_cast<unsigned>(fields)) | ...); }
+
+}
+
+SlideSaxHandler::SlideSaxHandler(std::pmr::memory_resource* resource, bool bareSlides, bool checkOnly)
+    : alloc_(resource), checkOnly_(checkOnly), texts_(alloc_), text_(alloc_) {
+    if (bareSlides) {
+        foundSlides_ = true;
+        contexts_.push_back(Context::Slides);
+    }
+}
+
+bool SlideSaxHandler::foundSlides() const { return foundSlides_; }
+int SlideSaxHandler::maxId() const { return maxId_; }
+
+std::vector<std::unique_ptr<Slide>> SlideSaxHandler::takeSlides() {
+    return std::move(slides_);
+}
+
+bool SlideSaxHandler::null() { return scalar(); }
+bool SlideSaxHandler::boolean(bool) { return scalar(); }
+bool SlideSaxHandler::number_integer(number_integer_t val) { return number(static_cast<double>(val)); }
+bool SlideSaxHandler::number_unsigned(number_unsigned_t val) { return number(static_cast<double>(val)); }
+bool SlideSaxHandler::number_float(number_float_t val, const string_t&) { return number(val); }
+bool SlideSaxHandler::binary(binary_t&) { return scalar(); }
+
+bool SlideSaxHandler::string(string_t& val) {
+    if (skipDepth_ > 0) return true;
+
+    switch (field_) {
+        case Field::Title: title_ = std::move(val); break;
+        case Field::Content: content_ = std::move(val); break;
+        case Field::Theme: theme_ = std::move(val); break;
+        case Field::TextContent: text_.content = val; break;
+        case Field::TextFont: text_.setFont(val); break;
+        case Field::TextColor: text_.setColor(val); break;
+        case Field::ShapeType: shapeType_ = std::move(val); break;
+        default: return scalar();
+    }
+
+    if (contexts_.back() == Context::Slide) slideFields_ |= bits(field_);
+    else if (contexts_.back() == Context::Text) textFields_ |= bits(field_);
+    else shapeFields_ |= bits(field_);
+    field_ = Field::None;
+    return true;
+}
+
+bool SlideSaxHandler::number(double val) {
+    if (skipDepth_ > 0) return true;
+
+    switch (field_) {
+        case Field::Id:
+            id_ = static_cast<int>(val);
+            slideFields_ |= bits(field_);
+            break;
+        case Field::TextSize:
+            text_.size = static_cast<float>(val);
+            textFields_ |= bits(field_);
+            break;
+        case Field::TextLineWidth:
+            text_.lineWidth = static_cast<float>(val);
+            break;
+        case Field::ShapeScale:
+            shapeScale_ = static_cast<float>(val);
+            shapeFields_ |= bits(field_);
+            break;
+        default:
+            break;
+    }
+
+    field_ = Field::None;
+    return true;
+}
+
+// Values the loader has no use for, or values of the wrong type; a missing
+// required field is reported when its object closes.
+bool SlideSaxHandler::scalar() {
+    if (skipDepth_ == 0) field_ = Field::None;
+    return true;
+}
+
+bool SlideSaxHandler::start_object(std::size_t) {
+    if (skipDepth_ > 0) {
+        ++skipDepth_;
+        return true;
+    }
+
+    if (contexts_.empty()) {
+        contexts_.push_back(Context::Document);
+    } else if (contexts_.back() == Context::Slides) {
+        slideFields_ = 0;
+        texts_.clear();
+        shapes_.clear();
+        contexts_.push_back(Context::Slide);
+    } else if (contexts_.back() == Context::Texts) {
+        text_ = Text(alloc_);
+        textFields_ = 0;
+        contexts_.push_back(Context::Text);
+    } else if (contexts_.back() == Context::Shapes) {
+        shapeScale_ = 1.0f;
+        shapeFields_ = 0;
+        contexts_.push_back(Context::Shape);
+    } else {
+        skipDepth_ = 1;
+    }
+
+    field_ = Field::None;
+    return true;
+}
+
+bool SlideSaxHandler::key(string_t& val) {
+    if (skipDepth_ > 0) return true;
+
+    field_ = Field::None;
+    switch (contexts_.back()) {
+        case Context::Document:
+            if (val == "slides") field_ = Field::Slides;
+            break;
+        case Context::Slide:
+            if (val == "id") field_ = Field::Id;
+            else if (val == "title") field_ = Field::Title;
+            else if (val == "content") field_ = Field::Content;
+            else if (val == "theme") field_ = Field::Theme;
+            else if (val == "texts") field_ = Field::Texts;
+            else if (val == "shapes") field_ = Field::Shapes;
+            break;
+        case Context::Text:
+            if (val == "content") field_ = Field::TextContent;
+            else if (val == "size") field_ = Field::TextSize;
+            else if (val == "font") field_ = Field::TextFont;
+            else if (val == "color") field_ = Field::TextColor;
+            else if (val == "lineWidth") field_ = Field::TextLineWidth;
+            break;
+        case Context::Shape:
+            if (val == "type") field_ = Field::ShapeType;
+            else if (val == "scale") field_ = Field::ShapeScale;
+            break;
+        default:
+            break;
+    }
+
+    return true;
+}
+
+bool SlideSaxHandler::end_object() {
+    if (skipDepth_ > 0) {
+        --skipDepth_;
+        return true;
+    }
+
+    Context context = contexts_.back();
+    contexts_.pop_back();
+    if (context == Context::Slide) finishSlide();
+    else if (context == Context::Text) finishText();
+    else if (context == Context::Shape) finishShape();
+
+    return true;
+}
+
+bool SlideSaxHandler::start_array(std::size_t) {
+    if (skipDepth_ > 0) {
+        ++skipDepth_;
+        return true;
+    }
+
+    if (field_ == Field::Slides) {
+        foundSlides_ = true;
+        contexts_.push_back(Context::Slides);
+    } else if (field_ == Field::Texts) {
+        contexts_.push_back(Context::Texts);
+    } else if (field_ == Field::Shapes) {
+        contexts_.push_back(Context::Shapes);
+    } else {
+        skipDepth_ = 1;
+    }
+
+    field_ = Field::None;
+    return true;
+}
+
+bool SlideSaxHandler::end_array() {
+    if (skipDepth_ > 0) {
+        --skipDepth_;
+        return true;
+    }
+
+    contexts_.pop_back();
+    return true;
+}
+
+bool SlideSaxHandler::parse_error(std::size_t, const std::string&, const nlohmann::json::exception& ex) {
+    throw std::runtime_error(ex.what());
+}
+
+void SlideSaxHandler::finishSlide() {
+    unsigned required = bits(Field::Id, Field::Title, Field::Content, Field::Theme);
+    if ((slideFields_ & required) != required) {
+        throw std::runtime_error("Slide is missing id, title, content or theme");
+    }
+
+    maxId_ = std::max(maxId_, id_ + 1);
+    if (checkOnly_) return;
+
+    auto slide = std::make_unique<Slide>(id_, title_, content_, theme_, alloc_);
+    slide->reserve(texts_.size(), shapes_.size());
+    for (auto& text : texts_) {
+        slide->addText(std::move(text));
+    }
+    for (const auto& shape : shapes_) {
+        slide->addShape(shape);
+    }
+
+    slides_.push_back(std::move(slide));
+}
+
+void SlideSaxHandler::finishText() {
+    unsigned required = bits(Field::TextContent, Field::TextSize);
+    if ((textFields_ & required) != required) {
+        throw std::runtime_error("Text is missing content or size");
+    }
+
+    if (!checkOnly_) texts_.push_back(std::move(text_));
+}
+
+void SlideSaxHandler::finishShape() {
+    unsigned required = bits(Field::ShapeType, Field::ShapeScale);
+    if ((shapeFields_ & required) != required) {
+        throw std::runtime_error("Shape is missing type or scale");
+    }
+
+    Shape shape = ShapeFactory::createShape(shapeType_, shapeScale_);
+    if (!checkOnly_) shapes_.push_back(std::move(shape));
+}
@@ -1,59 +1,221 @@
 #include "../../include/serialization/SvgSerializer.hpp"
+#include "../../include/serialization/AtomicFile.hpp"
 #include "../../include/core/Slide.hpp"
 #include "../../include/core/SlideFactory.hpp"
+#include "../../include/core/SlidePatch.hpp"
 #include "../../include/interfaces/ISlideRepository.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <filesystem>
 #include <fstream>
-#include <sstream>
-#include <cmath>
 #include <iostream>
+#include <set>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
-void SvgSerializer::save(const ISlideRepository& repo, const std::string& filepath) const {
-    std::string svgContent = generateSvgContent(repo);
-    
-    std::ofstream outFile(filepath);
-    if (!outFile.is_open()) {
-        throw std::runtime_error("Failed to open file: " + filepath);
+namespace {
+
+const int SLIDE_WIDTH = 960;
+const int SLIDE_HEIGHT = 540;
+const int SLIDES_PER_ROW = 3;
+const int MARGIN = 40;
+
+// Split export manifest; bump the version whenever a slide's SVG changes.
+const char* const SPLIT_MANIFEST = "manifest.json";
+const int SPLIT_FORMAT = 1;
+
+// A shape symbol: its kind and the rounded size it is drawn at.
+using ShapeSymbol = std::pair<ShapeKind, int>;
+using ShapeSymbols = std::set<ShapeSymbol>;
+
+// Buffered SVG output; without a stream it keeps everything until take().
+class SvgWriter {
+public:
+    explicit SvgWriter(std::ostream& out) : out_(&out) {
+        buffer_.reserve(bufferSize);
     }
-    
-    outFile << svgContent;
-    outFile.close();
-    
-    std::cout << "SVG exported successfully to: " << filepath << std::endl;
-}
 
-void SvgSerializer::load(ISlideRepository& repo, SlideFactory& factory, const std::string& filepath) {
-    throw std::runtime_error("SVG format is export-only and does not support loading");
+    SvgWriter() : out_(nullptr) {}
+
+    ~SvgWriter() { flush(); }
+
+    std::string take() {
+        std::string result = std::move(buffer_);
+        buffer_.clear();
+        return result;
+    }
+
+    SvgWriter& operator<<(std::string_view str) {
+        if (out_ && buffer_.size() + str.size() > bufferSize) flush();
+        buffer_.append(str.data(), str.size());
+        return *this;
+    }
+
+    SvgWriter& operator<<(const char* str) { return *this << std::string_view(str); }
+
+    SvgWriter& operator<<(int number) {
+        char digits[16];
+        auto result = std::to_chars(digits, digits + sizeof(digits), number);
+        return *this << std::string_view(digits, static_cast<std::size_t>(result.ptr - digits));
+    }
+
+    // Same digits as std::ostream's default for floats (%g), but never
+    // affected by the locale.
+    SvgWriter& operator<<(float number) {
+        char digits[32];
+        auto result = std::to_chars(digits, digits + sizeof(digits), number, std::chars_format::general, 6);
+        return *this << std::string_view(digits, static_cast<std::size_t>(result.ptr - digits));
+    }
+
+    // Character data, with the characters XML reserves escaped.
+    void text(std::string_view str) {
+        std::size_t start = 0;
+        for (std::size_t i = 0; i < str.size(); ++i) {
+            const char* entity = nullptr;
+            switch (str[i]) {
+                case '<': entity = "&lt;"; break;
+                case '>': entity = "&gt;"; break;
+                case '&': entity = "&amp;"; break;
+                case '"': entity = "&quot;"; break;
+                default: continue;
+            }
+            *this << str.substr(start, i - start) << entity;
+            start = i + 1;
+        }
+        *this << str.substr(start);
+    }
+
+    void flush() {
+        if (!out_) return;
+        out_->write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        buffer_.clear();
+    }
+
+private:
+    static constexpr std::size_t bufferSize = 1 << 16;
+
+    std::ostream* out_;
+    std::string buffer_;
+};
+
+// Markup of each ShapeKind split around its numbers: pieces[0], number 0,
+// pieces[1], ..., pieces[n]. `name` prefixes the kind's symbol IDs.
+struct ShapeMarkup {
+    std::string_view name;
+    std::size_t count;
+    std::string_view pieces[9];
+};
+
+const ShapeMarkup SHAPE_MARKUP[] = {
+    // Triangle: apex, bottom left and bottom right corners, label position.
+    {"tri", 8, {"    <polygon points=\"", ",", " ", ",", " ", ",",
+         "\" fill=\"#90EE90\" stroke=\"#228B22\" stroke-width=\"2\"/>\n    <text x=\"", "\" y=\"",
+         "\" class=\"shape-text\">Tri</text>\n"}},
+    // Circle: centre, radius, label position.
+    {"circle", 5, {"    <circle cx=\"", "\" cy=\"", "\" r=\"",
+         "\" fill=\"#87CEEB\" stroke=\"#4A90E2\" stroke-width=\"2\"/>\n    <text x=\"", "\" y=\"",
+         "\" class=\"shape-text\">Circle</text>\n"}},
+    // Rectangle: corner, width, height, label position.
+    {"rect", 6, {"    <rect x=\"", "\" y=\"", "\" width=\"", "\" height=\"",
+         "\" fill=\"#FFB6C1\" stroke=\"#FF1493\" stroke-width=\"2\"/>\n    <text x=\"", "\" y=\"",
+         "\" class=\"shape-text\">Rect</text>\n"}},
+    // Ellipse: centre, radii, label position.
+    {"ell", 6, {"    <ellipse cx=\"", "\" cy=\"", "\" rx=\"", "\" ry=\"",
+         "\" fill=\"#DDA0DD\" stroke=\"#8B008B\" stroke-width=\"2\"/>\n    <text x=\"", "\" y=\"",
+         "\" class=\"shape-text\">Ell</text>\n"}},
+};
+
+int shapeSize(const Shape& shape) {
+    return static_cast<int>(40 * shape.getScale());
 }
 
-std::string SvgSerializer::generateSvgContent(const ISlideRepository& repo) const {
-    const int SLIDE_WIDTH = 960;
-    const int SLIDE_HEIGHT = 540;
-    const int SLIDES_PER_ROW = 3;
-    const int MARGIN = 40;
-    const int SPACING = 30;
-    
-    std::ostringstream svg;
-    
-    int numSlides = 0;
-    for (int i = 0; i < 1000; i++) {
-        if (const_cast<ISlideRepository&>(repo).getSlideById(i)) {
-            numSlides++;
-        } else if (i > 0) {
-            break; 
+// Numbers of a `kind` shape of `size` at (baseX, baseY); false if it has no markup.
+bool shapeNumbers(ShapeKind kind, int size, int baseX, int baseY, std::array<int, 8>& numbers) {
+    switch (kind) {
+        case ShapeKind::Triangle: {
+            int py1 = baseY - size;
+            int py2 = baseY + size;
+            numbers = {baseX, py1, baseX - size, py2, baseX + size, py2, baseX - 20, baseY + 35};
+            return true;
         }
+        case ShapeKind::Circle:
+            numbers = {baseX, baseY, size, baseX - 15, baseY + 25};
+            return true;
+        case ShapeKind::Rectangle:
+            numbers = {baseX - size, baseY - size/2, size * 2, size, baseX - 25, baseY + 25};
+            return true;
+        case ShapeKind::Ellipse:
+            numbers = {baseX, baseY, static_cast<int>(size * 1.5), size, baseX - 20, baseY + 25};
+            return true;
+        default:
+            return false;
     }
-    
-    if (numSlides == 0) {
-        numSlides = 1;
+}
+
+void writeMarkup(SvgWriter& svg, ShapeKind kind, const std::array<int, 8>& numbers) {
+    const ShapeMarkup& markup = SHAPE_MARKUP[static_cast<std::size_t>(kind)];
+    for (std::size_t i = 0; i < markup.count; ++i) {
+        svg << markup.pieces[i] << numbers[i];
     }
-    
-    int numRows = (numSlides + SLIDES_PER_ROW - 1) / SLIDES_PER_ROW;
-    int totalWidth = SLIDES_PER_ROW * SLIDE_WIDTH + (SLIDES_PER_ROW + 1) * MARGIN;
-    int totalHeight = numRows * SLIDE_HEIGHT + (numRows + 1) * MARGIN;
-    
+    svg << markup.pieces[markup.count];
+}
+
+void writeSymbolId(SvgWriter& svg, const ShapeSymbol& symbol) {
+    svg << SHAPE_MARKUP[static_cast<std::size_t>(symbol.first)].name << "-" << symbol.second;
+}
+
+// With `symbols`, a <use> of the shape's symbol instead of the shape.
+void writeShape(SvgWriter& svg, const Shape& shape, int slideIndex, int shapeIndex, bool symbols) {
+    ShapeKind kind = shape.getKind();
+
+    int row = slideIndex / 3;
+    int col = slideIndex % 3;
+    int baseX = 40 + col * 330 + (shapeIndex % 3) * 100;
+    int baseY = 40 + row * 570 + 250 + (shapeIndex / 3) * 120;
+
+    int size = shapeSize(shape);
+
+    std::array<int, 8> numbers;
+    if (!shapeNumbers(kind, size, baseX, baseY, numbers)) {
+        return;
+    }
+    if (symbols) {
+        svg << "    <use href=\"#";
+        writeSymbolId(svg, {kind, size});
+        svg << "\" x=\"" << baseX << "\" y=\"" << baseY << "\"/>\n";
+    } else {
+        writeMarkup(svg, kind, numbers);
+    }
+}
+
+void writeText(SvgWriter& svg, const Text& text, int slideIndex, int textIndex) {
+    int row = slideIndex / 3;
+    int col = slideIndex % 3;
+    int x = 40 + col * 330 + 15;
+    int y = 40 + row * 570 + 85 + textIndex * 25;
+
+    svg << "    <text x=\"" << x << "\" y=\"" << y << "\" class=\"shape-text\" fill=\"";
+    svg.text(text.colorName());
+    svg << "\" font-family=\"";
+    svg.text(text.fontName());
+    svg << "\" font-size=\"" << (12 * text.size) << "\">";
+    std::string_view content(text.content);
+    if (content.length() > 40) {
+        svg.text(content.substr(0, 37));
+        svg << "...";
+    } else {
+        svg.text(content);
+    }
+    svg << "</text>\n";
+}
+
+void writeDocumentHead(SvgWriter& svg, int totalWidth, int totalHeight) {
     svg << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
-    svg << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << totalWidth 
-        << "\" height=\"" << totalHeight << "\" viewBox=\"0 0 " << totalWidth 
+    svg << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << totalWidth
+        << "\" height=\"" << totalHeight << "\" viewBox=\"0 0 " << totalWidth
         << " " << totalHeight << "\">\n";
     svg << "  <style>\n";
     svg << "    .slide-bg { fill: white; stroke: #333; stroke-width: 2; }\n";
@@ -61,119 +223,296 @@ std::string SvgSerializer::generateSvgContent(const ISlideRepository& repo) cons
     svg << "    .slide-text { font-size: 14px; fill: #666; }\n";
     svg << "    .shape-text { font-size: 12px; fill: #000; }\n";
     svg << "  </style>\n";
-    
-    int slideNum = 0;
-    for (int i = 0; i < 1000 && slideNum < numSlides; i++) {
-        Slide* slide = const_cast<ISlideRepository&>(repo).getSlideById(i);
-        if (!slide) continue;
-        
-        int row = slideNum / SLIDES_PER_ROW;
-        int col = slideNum % SLIDES_PER_ROW;
-        int x = MARGIN + col * (SLIDE_WIDTH + MARGIN);
-        int y = MARGIN + row * (SLIDE_HEIGHT + MARGIN);
-        
-        svg << "  <g id=\"slide-" << slide->getId() << "\">\n";
-        svg << "    <rect x=\"" << x << "\" y=\"" << y << "\" width=\"" << SLIDE_WIDTH 
+}
+
+// Head of the whole-deck document, sized for `slideCount` slides.
+void writeHead(SvgWriter& svg, std::size_t slideCount) {
+    int numSlides = static_cast<int>(slideCount);
+
+    if (numSlides == 0) {
+        numSlides = 1;
+    }
+
+    int numRows = (numSlides + SLIDES_PER_ROW - 1) / SLIDES_PER_ROW;
+    int totalWidth = SLIDES_PER_ROW * SLIDE_WIDTH + (SLIDES_PER_ROW + 1) * MARGIN;
+    int totalHeight = numRows * SLIDE_HEIGHT + (numRows + 1) * MARGIN;
+    writeDocumentHead(svg, totalWidth, totalHeight);
+}
+
+// Atomic but not synced: a split export is a cache the next run rebuilds.
+void replaceFile(const std::filesystem::path& path, const std::string& contents) {
+    AtomicFile file(path.string());
+    if (!file.isOpen()) {
+        throw std::runtime_error("Failed to open file: " + path.string());
+    }
+    file.stream().write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    if (!file.commit(std::string(), false)) {
+        throw std::runtime_error("Failed to write file: " + path.string());
+    }
+}
+
+// The `occurrence`th slide with `id` (from 1) gets its own file.
+std::string splitFileName(int id, int occurrence) {
+    std::string name = "slide-" + std::to_string(id);
+    if (occurrence > 1) {
+        name += "-" + std::to_string(occurrence);
+    }
+    return name + ".svg";
+}
+
+// Adds the symbols writeSlide() uses for `slide` in symbol mode.
+void collectSymbols(const Slide& slide, ShapeSymbols& symbols) {
+    const auto& shapes = slide.getShapes();
+    for (size_t j = 0; j < shapes.size() && j < 6; j++) {
+        symbols.insert({shapes[j].getKind(), shapeSize(shapes[j])});
+    }
+}
+
+// Symbol-mode <defs>: the slide background and each shape drawn around the origin.
+void writeDefs(SvgWriter& svg, const ShapeSymbols& symbols) {
+    svg << "  <defs>\n";
+    svg << "    <symbol id=\"slide\" overflow=\"visible\">\n";
+    svg << "    <rect width=\"" << SLIDE_WIDTH << "\" height=\"" << SLIDE_HEIGHT << "\" class=\"slide-bg\"/>\n";
+    svg << "    </symbol>\n";
+    for (const auto& symbol : symbols) {
+        std::array<int, 8> numbers;
+        if (!shapeNumbers(symbol.first, symbol.second, 0, 0, numbers)) {
+            continue;
+        }
+        svg << "    <symbol id=\"";
+        writeSymbolId(svg, symbol);
+        svg << "\" overflow=\"visible\">\n";
+        writeMarkup(svg, symbol.first, numbers);
+        svg << "    </symbol>\n";
+    }
+    svg << "  </defs>\n";
+}
+
+// The <g> of the slide at `index`; depends only on the slide and `index`.
+void writeSlide(SvgWriter& svg, const Slide& slide, std::size_t index, bool symbols) {
+    int slideNum = static_cast<int>(index);
+
+    int row = slideNum / SLIDES_PER_ROW;
+    int col = slideNum % SLIDES_PER_ROW;
+    int x = MARGIN + col * (SLIDE_WIDTH + MARGIN);
+    int y = MARGIN + row * (SLIDE_HEIGHT + MARGIN);
+
+    svg << "  <g id=\"slide-" << slide.getId() << "\">\n";
+    if (symbols) {
+        svg << "    <use href=\"#slide\" x=\"" << x << "\" y=\"" << y << "\"/>\n";
+    } else {
+        svg << "    <rect x=\"" << x << "\" y=\"" << y << "\" width=\"" << SLIDE_WIDTH
             << "\" height=\"" << SLIDE_HEIGHT << "\" class=\"slide-bg\"/>\n";
-        
-        svg << "    <text x=\"" << (x + 15) << "\" y=\"" << (y + 30) 
-            << "\" class=\"slide-title\">" << slide->getTitle() << "</text>\n";
-        
-        svg << "    <text x=\"" << (x + 15) << "\" y=\"" << (y + 55) 
-            << "\" class=\"slide-text\">Theme: " << slide->getTheme() << "</text>\n";
-        
-        const auto& texts = slide->getTexts();
-        int textY = y + 85;
-        for (size_t j = 0; j < texts.size() && j < 3; j++) {
-            svg << textToSvg(texts[j], slideNum, j);
-            textY += 25;
+    }
+
+    svg << "    <text x=\"" << (x + 15) << "\" y=\"" << (y + 30)
+        << "\" class=\"slide-title\">";
+    svg.text(slide.titleView());
+    svg << "</text>\n";
+
+    svg << "    <text x=\"" << (x + 15) << "\" y=\"" << (y + 55)
+        << "\" class=\"slide-text\">Theme: ";
+    svg.text(slide.themeView());
+    svg << "</text>\n";
+
+    const auto& texts = slide.getTexts();
+    for (size_t j = 0; j < texts.size() && j < 3; j++) {
+        writeText(svg, texts[j], slideNum, static_cast<int>(j));
+    }
+
+    const auto& shapes = slide.getShapes();
+    for (size_t j = 0; j < shapes.size() && j < 6; j++) {
+        writeShape(svg, shapes[j], slideNum, static_cast<int>(j), symbols);
+    }
+
+    svg << "  </g>\n";
+}
+
+}
+
+SvgSerializer::SvgSerializer(bool symbols) : symbols_(symbols) {}
+
+void SvgSerializer::save(const ISlideView& view, const std::string& filepath) const {
+    AtomicFile file(filepath);
+    if (!file.isOpen()) {
+        throw std::runtime_error("Failed to open file: " + filepath);
+    }
+
+    write(view, file.stream());
+    if (!file.commit()) {
+        throw std::runtime_error("Failed to write file: " + filepath);
+    }
+
+    std::cout << "SVG exported successfully to: " << filepath << std::endl;
+}
+
+// Renders rounds of one slide range per worker and writes them in order.
+void SvgSerializer::saveParallel(const ISlideView& view, const std::string& filepath, unsigned workers) const {
+    constexpr std::size_t slidesPerRange = 512;
+
+    unsigned threadLimit = workers != 0 ? workers : std::thread::hardware_concurrency();
+    if (threadLimit <= 1) {
+        save(view, filepath);
+        return;
+    }
+
+    AtomicFile file(filepath);
+    if (!file.isOpen()) {
+        throw std::runtime_error("Failed to open file: " + filepath);
+    }
+    std::ostream& outFile = file.stream();
+
+    // Gathered here, as visiting a lazy slide builds it.
+    std::vector<const Slide*> slides;
+    slides.reserve(view.slideCount());
+    view.forEachSlide([&](const Slide& slide, std::size_t) { slides.push_back(&slide); });
+    std::size_t count = slides.size();
+
+    {
+        SvgWriter head(outFile);
+        writeHead(head, count);
+        if (symbols_) {
+            ShapeSymbols symbols;
+            for (const Slide* slide : slides) {
+                collectSymbols(*slide, symbols);
+            }
+            writeDefs(head, symbols);
+        }
+    }
+
+    std::vector<std::string> pieces(threadLimit);
+    for (std::size_t begin = 0; begin < count; begin += threadLimit * slidesPerRange) {
+        std::size_t ranges = std::min<std::size_t>(threadLimit, (count - begin + slidesPerRange - 1) / slidesPerRange);
+        auto render = [&](std::size_t range) {
+            std::size_t from = begin + range * slidesPerRange;
+            std::size_t to = std::min(count, from + slidesPerRange);
+            SvgWriter svg;
+            for (std::size_t index = from; index < to; ++index) {
+                writeSlide(svg, *slides[index], index, symbols_);
+            }
+            pieces[range] = svg.take();
+        };
+
+        std::vector<std::thread> threads;
+        std::size_t started = 1;
+        try {
+            for (; started < ranges; ++started) {
+                threads.emplace_back(render, started);
+            }
+        } catch (const std::system_error&) {
+            // Ranges without a thread are rendered here below.
+        }
+        render(0);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (std::size_t range = started; range < ranges; ++range) {
+            render(range);
+        }
+
+        for (std::size_t range = 0; range < ranges; ++range) {
+            outFile.write(pieces[range].data(), static_cast<std::streamsize>(pieces[range].size()));
         }
-        
-        const auto& shapes = slide->getShapes();
-        int shapeX = x + 20;
-        int shapeY = y + 250;
-        int shapeSpacing = 120;
-        
-        for (size_t j = 0; j < shapes.size() && j < 6; j++) {
-            if (j > 0 && j % 3 == 0) {
-                shapeX = x + 20;
-                shapeY += shapeSpacing;
+    }
+
+    outFile << "</svg>\n";
+    if (!file.commit()) {
+        throw std::runtime_error("Failed to write file: " + filepath);
+    }
+
+    std::cout << "SVG exported successfully to: " << filepath << std::endl;
+}
+
+// Re-renders only slides whose file is missing or whose manifest hash differs.
+void SvgSerializer::saveSplit(const ISlideView& view, const std::string& directory) const {
+    namespace fs = std::filesystem;
+
+    fs::path dir(directory);
+    fs::create_directories(dir);
+    fs::path manifestPath = dir / SPLIT_MANIFEST;
+
+    std::unordered_map<std::string, std::uint64_t> previous;
+    bool reusable = false;
+    std::ifstream manifestIn(manifestPath);
+    if (manifestIn.is_open()) {
+        try {
+            nlohmann::json manifest = nlohmann::json::parse(manifestIn);
+            reusable = manifest.value("svg", 0) == SPLIT_FORMAT && manifest.value("symbols", false) == symbols_;
+            for (const auto& entry : manifest.at("slides")) {
+                previous[entry.at("file").get<std::string>()] = entry.at("hash").get<std::uint64_t>();
             }
-            svg << shapeToSvg(*shapes[j], slideNum, j);
-            shapeX += shapeSpacing;
+        } catch (const nlohmann::json::exception&) {
+            // Unreadable: render every slide.
+            reusable = false;
         }
-        
-        svg << "  </g>\n";
-        slideNum++;
+        manifestIn.close();
     }
-    
-    svg << "</svg>\n";
-    return svg.str();
+
+    nlohmann::json entries = nlohmann::json::array();
+    std::size_t rendered = 0;
+    bool manifestRemoved = false;
+    std::unordered_map<int, int> occurrences;
+    view.forEachSlide([&](const Slide& slide, std::size_t) {
+        int id = slide.getId();
+        std::uint64_t hash = SlidePatch::contentHash(slide);
+        std::string fileName = splitFileName(id, ++occurrences[id]);
+
+        auto cached = previous.find(fileName);
+        bool current = reusable && cached != previous.end() && cached->second == hash &&
+                       fs::exists(dir / fileName);
+        if (cached != previous.end()) {
+            previous.erase(cached);
+        }
+        if (!current) {
+            // A run that fails from here on leaves no stale manifest.
+            if (!manifestRemoved) {
+                fs::remove(manifestPath);
+                manifestRemoved = true;
+            }
+            SvgWriter svg;
+            writeDocumentHead(svg, SLIDE_WIDTH + 2 * MARGIN, SLIDE_HEIGHT + 2 * MARGIN);
+            if (symbols_) {
+                ShapeSymbols symbols;
+                collectSymbols(slide, symbols);
+                writeDefs(svg, symbols);
+            }
+            writeSlide(svg, slide, 0, symbols_);
+            svg << "</svg>\n";
+            replaceFile(dir / fileName, svg.take());
+            ++rendered;
+        }
+        entries.push_back({{"id", id}, {"file", fileName}, {"hash", hash}});
+    });
+
+    // Only plain file names are removed, whatever the old manifest says.
+    std::error_code error;
+    for (const auto& [fileName, hash] : previous) {
+        if (fs::path(fileName).filename() == fileName) {
+            fs::remove(dir / fileName, error);
+        }
+    }
+
+    std::size_t count = entries.size();
+    nlohmann::json manifest = {{"svg", SPLIT_FORMAT}, {"symbols", symbols_}, {"slides", std::move(entries)}};
+    replaceFile(manifestPath, manifest.dump(4) + "\n");
+
+    std::cout << "SVG exported to " << directory << ": " << rendered << " of " << count
+              << " slides rendered" << std::endl;
 }
 
-std::string SvgSerializer::shapeToSvg(const IShape& shape, int slideIndex, int shapeIndex) const {
-    std::ostringstream svg;
-    std::string type = shape.getType();
-    float scale = shape.getScale();
-    
-    int row = slideIndex / 3;
-    int col = slideIndex % 3;
-    int baseX = 40 + col * 330 + (shapeIndex % 3) * 100;
-    int baseY = 40 + row * 570 + 250 + (shapeIndex / 3) * 120;
-    
-    int size = static_cast<int>(40 * scale);
-    
-    if (type == "Circle") {
-        svg << "    <circle cx=\"" << baseX << "\" cy=\"" << baseY << "\" r=\"" 
-            << size << "\" fill=\"#87CEEB\" stroke=\"#4A90E2\" stroke-width=\"2\"/>\n";
-        svg << "    <text x=\"" << (baseX - 15) << "\" y=\"" << (baseY + 25) 
-            << "\" class=\"shape-text\">Circle</text>\n";
-    } else if (type == "Rectangle") {
-        svg << "    <rect x=\"" << (baseX - size) << "\" y=\"" << (baseY - size/2) 
-            << "\" width=\"" << (size * 2) << "\" height=\"" << size 
-            << "\" fill=\"#FFB6C1\" stroke=\"#FF1493\" stroke-width=\"2\"/>\n";
-        svg << "    <text x=\"" << (baseX - 25) << "\" y=\"" << (baseY + 25) 
-            << "\" class=\"shape-text\">Rect</text>\n";
-    } else if (type == "Triangle") {
-        int points = baseX;
-        int py1 = baseY - size;
-        int py2 = baseY + size;
-        svg << "    <polygon points=\"" << baseX << "," << py1 << " " 
-            << (baseX - size) << "," << py2 << " " 
-            << (baseX + size) << "," << py2 
-            << "\" fill=\"#90EE90\" stroke=\"#228B22\" stroke-width=\"2\"/>\n";
-        svg << "    <text x=\"" << (baseX - 20) << "\" y=\"" << (baseY + 35) 
-            << "\" class=\"shape-text\">Tri</text>\n";
-    } else if (type == "Ellipse") {
-        int rx = static_cast<int>(size * 1.5);
-        int ry = size;
-        svg << "    <ellipse cx=\"" << baseX << "\" cy=\"" << baseY << "\" rx=\"" 
-            << rx << "\" ry=\"" << ry 
-            << "\" fill=\"#DDA0DD\" stroke=\"#8B008B\" stroke-width=\"2\"/>\n";
-        svg << "    <text x=\"" << (baseX - 20) << "\" y=\"" << (baseY + 25) 
-            << "\" class=\"shape-text\">Ell</text>\n";
-    }
-    
-    return svg.str();
-}
-
-std::string SvgSerializer::textToSvg(const Text& text, int slideIndex, int textIndex) const {
-    std::ostringstream svg;
-    
-    int row = slideIndex / 3;
-    int col = slideIndex % 3;
-    int x = 40 + col * 330 + 15;
-    int y = 40 + row * 570 + 85 + textIndex * 25;
-    
-    std::string displayText = text.content;
-    if (displayText.length() > 40) {
-        displayText = displayText.substr(0, 37) + "...";
-    }
-    
-    svg << "    <text x=\"" << x << "\" y=\"" << y << "\" class=\"shape-text\" fill=\"" 
-        << text.color << "\" font-family=\"" << text.font 
-        << "\" font-size=\"" << (12 * text.size) << "\">" 
-        << displayText << "</text>\n";
-    
-    return svg.str();
-}
\ No newline at end of file
+bool SvgSerializer::load(ISlideRepository&, SlideFactory&, const std::string&) {
+    throw std::runtime_error("SVG format is export-only and does not support loading");
+}
+
+// Streams each slide as it is laid out, after <defs> in symbol mode.
+void SvgSerializer::write(const ISlideView& view, std::ostream& out) const {
+    SvgWriter svg(out);
+    writeHead(svg, view.slideCount());
+    if (symbols_) {
+        ShapeSymbols symbols;
+        view.forEachSlide([&](const Slide& slide, std::size_t) { collectSymbols(slide, symbols); });
+        writeDefs(svg, symbols);
+    }
+    view.forEachSlide([&](const Slide& slide, std::size_t index) { writeSlide(svg, slide, index, symbols_); });
+    svg << "</svg>\n";
+}
@@ -0,0 +1,44 @@
+# Runs test_commands.txt, then checks that every saved format loads back to
+# the same presentation and that a --diff/--patch round trip reproduces the
+# edited deck. Invoked by CTest:
+#   cmake -DEDITOR=<SlideEditor> -DCOMMANDS=<test_commands.txt> -DWORK_DIR=<dir> -P round_trip.cmake
+
+file(REMOVE_RECURSE "${WORK_DIR}")
+file(MAKE_DIRECTORY "${WORK_DIR}")
+
+# Runs the editor with `input` on stdin, failing on a non-zero exit code or
+# any error message.
+function(run_editor input)
+    execute_process(
+        COMMAND "${EDITOR}" ${ARGN}
+        INPUT_FILE "${input}"
+        WORKING_DIRECTORY "${WORK_DIR}"
+        RESULT_VARIABLE result
+        OUTPUT_VARIABLE output
+        ERROR_VARIABLE errors)
+    if(NOT result EQUAL 0 OR output MATCHES "Error" OR errors MATCHES "Error")
+        message(FATAL_ERROR "SlideEditor ${ARGN} failed (${result}):\n${output}${errors}")
+    endif()
+endfunction()
+
+function(expect_same_file actual expected)
+    execute_process(
+        COMMAND "${CMAKE_COMMAND}" -E compare_files "${WORK_DIR}/${actual}" "${WORK_DIR}/${expected}"
+        RESULT_VARIABLE different)
+    if(different)
+        message(FATAL_ERROR "${actual} differs from ${expected}")
+    endif()
+endfunction()
+
+run_editor("${COMMANDS}")
+
+foreach(format sbin sbin.slz json.slz cbor msgpack)
+    file(WRITE "${WORK_DIR}/reload.txt" "load deck.${format}\nsave reloaded.json\nexit\n")
+    run_editor("${WORK_DIR}/reload.txt")
+    expect_same_file(reloaded.json deck.json)
+endforeach()
+
+file(WRITE "${WORK_DIR}/empty.txt" "")
+run_editor("${WORK_DIR}/empty.txt" --diff deck.json edited.json changes.patch)
+run_editor("${WORK_DIR}/empty.txt" --patch deck.json changes.patch patched.json)
+expect_same_file(patched.json edited.json)